@@ -0,0 +1,49 @@
+/**
+ * @file BenchKktAssembly.cpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <solver/optimizer/LinSolver.hpp>
+#include "BenchProblems.hpp"
+
+using namespace solver;
+
+double initializationTime(int horizon, SolverSetting& setting, int& kkt_nnz)
+{
+  TrajectoryProblem problem;
+  problem.build(horizon, setting);
+
+  LinSolver linear_solver;
+  auto start = std::chrono::high_resolution_clock::now();
+  linear_solver.initialize(problem.cone, setting, problem.storage);
+  auto end = std::chrono::high_resolution_clock::now();
+
+  kkt_nnz = linear_solver.kktNonZeros();
+  return std::chrono::duration<double, std::milli>(end-start).count();
+}
+
+int main(int argc, char** argv)
+{
+  SolverSetting setting;
+  setting.initialize(argc>1 ? argv[1] : TEST_PATH+std::string("default_stgs.yaml"));
+
+  // with a warm ordering cache, initialization is dominated by assembly of the kkt matrix
+  std::string cache_dir = argc>2 ? argv[2] : "/tmp/bench_kkt_assembly_cache";
+  std::printf("%8s %12s %14s %14s %16s\n", "horizon", "nnz(kkt)", "cold [ms]", "warm [ms]", "warm [ns/nnz]");
+  for (int horizon : {250, 1000, 4000, 16000}) {
+    int kkt_nnz;
+    setting.set(SolverStringParam_OrderingCacheDir, "");
+    double cold = initializationTime(horizon, setting, kkt_nnz);
+    setting.set(SolverStringParam_OrderingCacheDir, cache_dir);
+    initializationTime(horizon, setting, kkt_nnz);
+    double warm = initializationTime(horizon, setting, kkt_nnz);
+    std::printf("%8d %12d %14.3f %14.3f %16.3f\n", horizon, kkt_nnz, cold, warm, 1.0e6*warm/kkt_nnz);
+  }
+
+  return 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file BenchKktOrdering.cpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <solver/optimizer/LinSolver.hpp>
+#include "BenchProblems.hpp"
+
+using namespace solver;
+
+int main(int argc, char** argv)
+{
+  SolverSetting setting;
+  setting.initialize(argc>1 ? argv[1] : TEST_PATH+std::string("default_stgs.yaml"));
+
+  const char* names[] = {"amd", "nested dissection"};
+  std::printf("%8s %10s %18s %12s %12s %12s %12s\n", "horizon", "kkt size", "ordering", "nnz(L)", "flops", "etree height", "time [ms]");
+  for (int horizon : {25, 100, 400, 1600}) {
+    for (int ordering=0; ordering<2; ordering++) {
+      TrajectoryProblem problem;
+      problem.build(horizon, setting);
+      setting.set(SolverIntParam_KktOrdering, ordering);
+
+      LinSolver linear_solver;
+      auto start = std::chrono::high_resolution_clock::now();
+      linear_solver.initialize(problem.cone, setting, problem.storage);
+      auto end = std::chrono::high_resolution_clock::now();
+
+      std::printf("%8d %10d %18s %12d %12.3e %12d %12.3f\n", horizon, problem.cone.extSizeProb(), names[ordering],
+                  linear_solver.factorNonZeros(), linear_solver.factorFlops(), linear_solver.eliminationTreeHeight(),
+                  std::chrono::duration<double, std::milli>(end-start).count());
+    }
+  }
+
+  return 0;
+}
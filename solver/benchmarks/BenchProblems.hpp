@@ -0,0 +1,128 @@
+/**
+ * @file BenchProblems.hpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+#include <solver/interface/Cone.hpp>
+
+namespace solver {
+
+  /**
+   * Chain-like trajectory problem of the given horizon: states and inputs per
+   * stage, linear dynamics as equality constraints, bounds on states and inputs
+   * as linear inequalities and a second-order cone on the inputs of each stage.
+   */
+  struct TrajectoryProblem
+  {
+    void build(int horizon, SolverSetting& setting, int nx = 9, int nu = 6)
+    {
+      int nstage = nx+nu;
+      int nvars = horizon*nstage;
+      int nleq = (horizon-1)*nx;
+      int nlineq = 2*nvars;
+      Eigen::VectorXi nsoc = Eigen::VectorXi::Constant(horizon, nu+1);
+      cone.initialize(nvars, nleq, nlineq, nsoc);
+      storage.initialize(cone, setting);
+
+      // dynamics x[k+1] = x[k] + dt*(coupled states and inputs)
+      int row = 0;
+      for (int k=0; k<horizon-1; k++)
+        for (int i=0; i<nx; i++, row++) {
+          storage.addCoeff(Eigen::Triplet<double>(row, k*nstage+i, 1.0), true);
+          storage.addCoeff(Eigen::Triplet<double>(row, k*nstage+(i+1)%nx, 0.1), true);
+          storage.addCoeff(Eigen::Triplet<double>(row, k*nstage+nx+i%nu, 0.1), true);
+          storage.addCoeff(Eigen::Triplet<double>(row, (k+1)*nstage+i, -1.0), true);
+        }
+
+      // variable bounds as general inequalities
+      for (int i=0; i<nvars; i++) {
+        storage.addCoeff(Eigen::Triplet<double>(2*i, i, 1.0));
+        storage.addCoeff(Eigen::Triplet<double>(2*i+1, i, -1.0));
+      }
+
+      // norm of inputs bounded by last state of the stage
+      row = nlineq;
+      for (int k=0; k<horizon; k++) {
+        storage.addCoeff(Eigen::Triplet<double>(row++, k*nstage+nx-1, -1.0));
+        for (int j=0; j<nu; j++)
+          storage.addCoeff(Eigen::Triplet<double>(row++, k*nstage+nx+j, -1.0));
+      }
+
+      storage.initializeMatrices();
+    }
+
+    Cone cone;
+    SolverStorage storage;
+  };
+
+  /**
+   * Conic problem dumped in the yaml format of the test problems: minimize c'x
+   * subject to A x = b and h - G x in the cone, with the linear rows of G first
+   * and second-order cones of sizes qvec after them. Matrices are given by
+   * triplets (row, col, val) and binary variables are relaxed. The data is
+   * kept, so that cones and storages can be built from it for every solve.
+   */
+  struct DumpedProblem
+  {
+    // returns false if the file does not hold a problem
+    bool load(const std::string& file)
+    {
+      YAML::Node problem = YAML::LoadFile(file);
+      if (!problem["problem_size"] || !problem["problem_data"]) { return false; }
+
+      const YAML::Node& size = problem["problem_size"];
+      const YAML::Node& data = problem["problem_data"];
+      name = file.substr(file.find_last_of('/')+1);
+      nvars = size["nvars"].as<int>();
+      nleq = size["nleq"].as<int>();
+      nlpc = size["nlpc"].as<int>();
+      qvec = size["qvec"].as<std::vector<int>>();
+      c = data["cvec"].as<std::vector<double>>();
+      b = data["bvec"].as<std::vector<double>>();
+      h = data["hvec"].as<std::vector<double>>();
+      this->readTriplets(data, "A", Acoeffs);
+      this->readTriplets(data, "G", Gcoeffs);
+      return true;
+    }
+
+    void build(Cone& cone, SolverStorage& storage, SolverSetting& setting) const
+    {
+      cone.initialize(nvars, nleq, nlpc, Eigen::Map<const Eigen::VectorXi>(qvec.data(), qvec.size()));
+      storage.initialize(cone, setting);
+      for (const Eigen::Triplet<double>& coeff : Acoeffs) { storage.addCoeff(coeff, true); }
+      for (const Eigen::Triplet<double>& coeff : Gcoeffs) { storage.addCoeff(coeff); }
+      storage.initializeMatrices();
+      storage.c() = Eigen::Map<const Eigen::VectorXd>(c.data(), c.size());
+      storage.b() = Eigen::Map<const Eigen::VectorXd>(b.data(), b.size());
+      storage.h() = Eigen::Map<const Eigen::VectorXd>(h.data(), h.size());
+    }
+
+    double cost(const Eigen::Ref<const Eigen::VectorXd>& x) const
+    {
+      return Eigen::Map<const Eigen::VectorXd>(c.data(), c.size()).dot(x);
+    }
+
+    void readTriplets(const YAML::Node& data, const std::string& mat, std::vector<Eigen::Triplet<double>>& coeffs)
+    {
+      std::vector<int> rows = data[mat+"row"].as<std::vector<int>>();
+      std::vector<int> cols = data[mat+"col"].as<std::vector<int>>();
+      std::vector<double> vals = data[mat+"val"].as<std::vector<double>>();
+      for (std::size_t id=0; id<vals.size(); id++) { coeffs.push_back(Eigen::Triplet<double>(rows[id], cols[id], vals[id])); }
+    }
+
+    std::string name;
+    int nvars, nleq, nlpc;
+    std::vector<int> qvec;
+    std::vector<double> c, b, h;
+    std::vector<Eigen::Triplet<double>> Acoeffs, Gcoeffs;
+  };
+
+}
@@ -0,0 +1,254 @@
+/**
+ * @file BenchRtLatency.cpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <pthread.h>
+#include <yaml-cpp/yaml.h>
+#include <solver/interface/Solver.hpp>
+#include "AllocationCounter.hpp"
+
+using namespace rt_solver;
+
+/**
+ * Latencies of a sequence of solves, reported as percentiles and as a
+ * histogram with bins of half an octave, together with the number of heap
+ * allocations performed while solving.
+ */
+struct LatencyStats
+{
+  LatencyStats(int num_samples) : num_samples_with_allocations(0), num_failures(0), allocations(0) { latencies.reserve(num_samples); }
+
+  template<typename Solve>
+  void measure(Solve& solve)
+  {
+    long allocations_before = num_allocations;
+    count_allocations = true;
+    auto start = std::chrono::steady_clock::now();
+    bool is_solved = solve();
+    auto end = std::chrono::steady_clock::now();
+    count_allocations = false;
+
+    latencies.push_back(std::chrono::duration<double, std::micro>(end-start).count());
+    if (num_allocations > allocations_before) { num_samples_with_allocations++;  allocations += num_allocations-allocations_before; }
+    if (!is_solved) { num_failures++; }
+  }
+
+  void print(const char* name)
+  {
+    std::sort(latencies.begin(), latencies.end());
+    int n = latencies.size();
+    auto percentile = [&](double q) { return latencies[std::max(0, int(std::ceil(q*n))-1)]; };
+
+    std::printf("\n%s: %d samples, %d failures, %ld allocations in %d samples\n", name, n, num_failures, allocations, num_samples_with_allocations);
+    std::printf("  %10s %10s %10s %10s %10s [us]\n", "p50", "p99", "p99.9", "max", "mean");
+    double mean = 0.0;
+    for (double latency : latencies) { mean += latency/n; }
+    std::printf("  %10.2f %10.2f %10.2f %10.2f %10.2f\n", percentile(0.5), percentile(0.99), percentile(0.999), latencies.back(), mean);
+
+    // bins with bounds 2^(k/2) us, counts are shown on a logarithmic scale not to hide the tail
+    int first_bin = int(std::floor(2.0*std::log2(std::max(latencies.front(), 1.e-3))));
+    int last_bin = int(std::floor(2.0*std::log2(std::max(latencies.back(), 1.e-3))));
+    std::vector<int> counts(last_bin-first_bin+1, 0);
+    for (double latency : latencies) { counts[int(std::floor(2.0*std::log2(std::max(latency, 1.e-3))))-first_bin]++; }
+    for (int bin=0; bin<int(counts.size()); bin++) {
+      int bar = counts[bin]>0 ? 1+int(6.0*std::log10(double(counts[bin]))) : 0;
+      std::printf("  [%10.2f, %10.2f) %9d %s\n", std::pow(2.0, 0.5*(first_bin+bin)), std::pow(2.0, 0.5*(first_bin+bin+1)),
+                  counts[bin], std::string(bar, '#').c_str());
+    }
+  }
+
+  std::vector<double> latencies;
+  int num_samples_with_allocations, num_failures;
+  long allocations;
+};
+
+/**
+ * Randomized qp of the size of a whole-body controller: joint accelerations,
+ * contact forces and torques as variables, dynamics and contact constraints as
+ * equalities and torque limits and friction cones as inequalities, with
+ * x = 0 strictly feasible for the inequalities. Either every sample is a new
+ * random problem, or the matrices are fixed and the vectors drift slowly as in
+ * a control loop, with warm starts and reuse of the hessian factor.
+ */
+template<int Num_Vars, int Max_Eq_Rows, int Max_Ineq_Rows>
+void benchQP(int num_samples, std::mt19937& generator, bool is_drifting)
+{
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  auto random = [&](double) { return uniform(generator); };
+  auto drift = [&](double value) { return std::min(1.0, std::max(-1.0, value + 1.e-3*uniform(generator))); };
+
+  RtQPSolver<Num_Vars, Max_Eq_Rows, Max_Ineq_Rows> qp_solver;
+  RtQPSolverInterface<Num_Vars, Max_Eq_Rows, Max_Ineq_Rows>& qp = qp_solver;
+  Eigen::Matrix<double, Num_Vars, Num_Vars> hessian_sqrt, hessian;
+  Eigen::Matrix<double, Num_Vars, 1> gradient;
+  Eigen::Matrix<double, Max_Eq_Rows, Num_Vars> eq_mat;
+  Eigen::Matrix<double, Max_Eq_Rows, 1> eq_vec;
+  Eigen::Matrix<double, Max_Ineq_Rows, Num_Vars> ineq_mat;
+  Eigen::Matrix<double, Max_Ineq_Rows, 1> ineq_vec, ineq_offset;
+  hessian_sqrt.setZero();  gradient.setZero();  eq_mat.setZero();  eq_vec.setZero();  ineq_mat.setZero();  ineq_offset.setZero();
+  qp.warmStart() = is_drifting;
+
+  auto solve = [&]() {
+    qp.reset(Num_Vars, 0, 0);
+    qp.objectiveQuadPart() = hessian;
+    qp.objectiveLinPart() = gradient;
+    qp.appendEqualities(eq_mat, eq_vec);
+    qp.appendInequalities(ineq_mat, ineq_vec);
+    return qp.optimize();
+  };
+
+  LatencyStats stats(num_samples);
+  for (int sample=0; sample<num_samples; sample++) {
+    if (!is_drifting || sample == 0) {
+      hessian_sqrt = hessian_sqrt.unaryExpr(random);
+      hessian.noalias() = hessian_sqrt*hessian_sqrt.transpose();
+      hessian.diagonal().array() += 1.e-2;
+      gradient = gradient.unaryExpr(random);
+      eq_mat = eq_mat.unaryExpr(random);
+      eq_vec = eq_vec.unaryExpr(random);
+      ineq_mat = ineq_mat.unaryExpr(random);
+      ineq_offset = ineq_offset.unaryExpr(random);
+    } else {
+      gradient = gradient.unaryExpr(drift);
+      eq_vec = eq_vec.unaryExpr(drift);
+      ineq_offset = ineq_offset.unaryExpr(drift);
+    }
+    ineq_vec = -0.5*(ineq_offset.array()+1.5);
+    stats.measure(solve);
+  }
+
+  char name[128];
+  std::snprintf(name, sizeof(name), "RtQPSolver<%d,%d,%d> %s", Num_Vars, Max_Eq_Rows, Max_Ineq_Rows,
+                is_drifting ? "drifting" : "random");
+  stats.print(name);
+}
+
+/**
+ * Tasks of a whole-body controller with three ranks: dynamics equalities and
+ * limits as inequalities, a tracking task and a posture regularization,
+ * formulated on fixed-size blocks with the allocation-free interface.
+ */
+template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
+class WholeBodyTasks : public RtHQPCost
+{
+  public:
+    typedef RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> RtModel_;
+    static const int Num_Dyn_Rows = Max_Eq_Rows/2;
+    static const int Num_Task_Rows = Max_Eq_Rows/3;
+
+  public:
+    WholeBodyTasks(RtModel_& prob_composer)
+      : prob_composer_(&prob_composer)
+    {
+      dyn_mat_.setZero();  dyn_vec_.setZero();  limit_mat_.setZero();  limit_vec_.setZero();
+      task_mat_.setZero();  task_vec_.setZero();  posture_mat_.setIdentity();  posture_vec_.setZero();
+    }
+    virtual ~WholeBodyTasks() {}
+
+    void updateAfterSolutionFound() {}
+    int maxRank() const { return 2; }
+    void addCostToHierarchy(int rank) const
+    {
+      if (rank == 0) {
+        prob_composer_->addLinConstr(dyn_mat_, '=', dyn_vec_);
+        prob_composer_->addLinConstr(limit_mat_, '<', limit_vec_);
+      }
+      else if (rank == 1) { prob_composer_->addLinConstr(task_mat_, '=', task_vec_); }
+      else if (rank == 2) { prob_composer_->addLinConstr(posture_mat_, '=', posture_vec_); }
+    }
+
+    template<typename Random>
+    void randomize(Random& random)
+    {
+      dyn_mat_ = dyn_mat_.unaryExpr(random);
+      dyn_vec_ = dyn_vec_.unaryExpr(random);
+      limit_mat_ = limit_mat_.unaryExpr(random);
+      limit_vec_ = 0.5*(limit_vec_.unaryExpr(random).array()+1.5);
+      task_mat_ = task_mat_.unaryExpr(random);
+      task_vec_ = task_vec_.unaryExpr(random);
+      posture_vec_ = posture_vec_.unaryExpr(random);
+    }
+
+  private:
+    RtModel_ *prob_composer_;
+
+    Eigen::Matrix<double, Num_Dyn_Rows, Num_OptVars> dyn_mat_;
+    Eigen::Matrix<double, Num_Dyn_Rows, 1> dyn_vec_;
+    Eigen::Matrix<double, Max_Ineq_Rows, Num_OptVars> limit_mat_;
+    Eigen::Matrix<double, Max_Ineq_Rows, 1> limit_vec_;
+    Eigen::Matrix<double, Num_Task_Rows, Num_OptVars> task_mat_;
+    Eigen::Matrix<double, Num_Task_Rows, 1> task_vec_;
+    Eigen::Matrix<double, Num_OptVars, Num_OptVars> posture_mat_;
+    Eigen::Matrix<double, Num_OptVars, 1> posture_vec_;
+};
+
+template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
+void benchHQP(int num_samples, std::mt19937& generator, const YAML::Node& hqp_solver_pars)
+{
+  static_assert(Num_OptVars <= Max_Eq_Rows, "Posture task requires one equality row per variable");
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  auto random = [&](double) { return uniform(generator); };
+
+  RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> rt_model(hqp_solver_pars);
+  WholeBodyTasks<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> tasks(rt_model);
+  rt_model.subCostComposers().push_back(static_cast<RtHQPCost*>(&tasks));
+  rt_model.initialize();
+
+  // the first solve sets up the buffers of the svd thread
+  tasks.randomize(random);
+  rt_model.solve();
+
+  auto solve = [&]() { return rt_model.solve(); };
+  LatencyStats stats(num_samples);
+  for (int sample=0; sample<num_samples; sample++) {
+    tasks.randomize(random);
+    stats.measure(solve);
+  }
+
+  char name[128];
+  std::snprintf(name, sizeof(name), "RtModel<%d,%d,%d>", Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars);
+  stats.print(name);
+}
+
+bool pinToCpu(int cpu)
+{
+  #ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0;
+  #else
+    return false;
+  #endif
+}
+
+// usage: bench_rt_latency [num_samples] [cpu] [hqp parameters yaml]
+int main(int argc, char** argv)
+{
+  int num_samples = argc>1 ? std::atoi(argv[1]) : 1000000;
+  int cpu = argc>2 ? std::atoi(argv[2]) : -1;
+  YAML::Node hqp_solver_pars;
+  if (argc>3) { hqp_solver_pars = YAML::LoadFile(argv[3]); }
+
+  if (cpu >= 0 && !pinToCpu(cpu)) { std::printf("could not pin benchmark to cpu %d\n", cpu); }
+  if (num_allocations < 0) { std::printf("allocations are not counted on this platform\n"); }
+
+  std::mt19937 generator(0);
+  benchQP<36, 18, 24>(num_samples, generator, false);
+  benchQP<36, 18, 24>(num_samples, generator, true);
+  benchHQP<24, 36, 36>(num_samples, generator, hqp_solver_pars);
+
+  return 0;
+}
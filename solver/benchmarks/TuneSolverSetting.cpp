@@ -0,0 +1,235 @@
+/**
+ * @file TuneSolverSetting.cpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-19
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdlib>
+#include <algorithm>
+#include <dirent.h>
+#include <solver/optimizer/IPSolver.hpp>
+#include "BenchProblems.hpp"
+
+using namespace solver;
+
+/**
+ * Parameter of the interior point solver included in the search, sampled
+ * uniformly or log-uniformly within its range.
+ */
+struct TunedParam
+{
+  const char* key;
+  int param;
+  bool is_int, is_log;
+  double lower, upper;
+};
+
+static const TunedParam tuned_params[] = {
+  {"equil_iterations",          SolverIntParam_EquilibrationIters,             true,  false, 0.0,     5.0    },
+  {"num_iter_ref_lin_solve",    SolverIntParam_NumIterRefinementsLinSolve,     true,  false, 1.0,     12.0   },
+  {"kkt_ordering",              SolverIntParam_KktOrdering,                    true,  false, 0.0,     1.0    },
+  {"dense_kkt_threshold",       SolverIntParam_DenseKktThreshold,              true,  false, 0.0,     256.0  },
+  {"dense_soc_threshold",       SolverIntParam_DenseSocThreshold,              true,  false, 0.0,     6.0    },
+  {"max_centrality_correctors", SolverIntParam_MaxCentralityCorrectors,        true,  false, 0.0,     3.0    },
+  {"static_regularization",     SolverDoubleParam_StaticRegularization,        false, true,  1.0e-10, 1.0e-6 },
+  {"dynamic_regularization",    SolverDoubleParam_DynamicRegularization,       false, true,  1.0e-9,  1.0e-5 },
+  {"dyn_reg_thresh",            SolverDoubleParam_DynamicRegularizationThresh, false, true,  1.0e-15, 1.0e-11},
+  {"lin_sys_accuracy",          SolverDoubleParam_LinearSystemAccuracy,        false, true,  1.0e-15, 1.0e-10},
+  {"err_reduction_factor",      SolverDoubleParam_ErrorReductionFactor,        false, false, 2.0,     10.0   },
+  {"max_step_length",           SolverDoubleParam_MaximumStepLength,           false, false, 0.95,    0.999  },
+  {"step_length_scaling",       SolverDoubleParam_StepLengthScaling,           false, false, 0.9,     0.99   },
+};
+static const int num_tuned_params = sizeof(tuned_params)/sizeof(TunedParam);
+
+/**
+ * Values of the tuned parameters together with the fastest solve time of
+ * each problem of the corpus evaluated so far.
+ */
+struct Candidate
+{
+  bool is_accurate;
+  std::vector<double> values, times;
+
+  double totalTime(int num_problems) const
+  {
+    double total = 0.0;
+    for (int i=0; i<num_problems; i++) { total += times[i]; }
+    return total;
+  }
+
+  void apply(SolverSetting& setting) const
+  {
+    for (int i=0; i<num_tuned_params; i++) {
+      if (tuned_params[i].is_int) { setting.set(static_cast<SolverIntParam>(tuned_params[i].param), static_cast<int>(values[i])); }
+      else { setting.set(static_cast<SolverDoubleParam>(tuned_params[i].param), values[i]); }
+    }
+  }
+};
+
+Candidate baseCandidate(const SolverSetting& setting)
+{
+  Candidate candidate;
+  candidate.is_accurate = true;
+  for (int i=0; i<num_tuned_params; i++) {
+    if (tuned_params[i].is_int) { candidate.values.push_back(setting.get(static_cast<SolverIntParam>(tuned_params[i].param))); }
+    else { candidate.values.push_back(setting.get(static_cast<SolverDoubleParam>(tuned_params[i].param))); }
+  }
+  return candidate;
+}
+
+Candidate randomCandidate(std::mt19937& generator)
+{
+  Candidate candidate;
+  candidate.is_accurate = true;
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  for (int i=0; i<num_tuned_params; i++) {
+    const TunedParam& p = tuned_params[i];
+    double u = unit(generator);
+    if (p.is_int) { candidate.values.push_back(std::min(std::floor(p.lower + u*(p.upper-p.lower+1.0)), p.upper)); }
+    else if (p.is_log) { candidate.values.push_back(std::exp(std::log(p.lower) + u*(std::log(p.upper)-std::log(p.lower)))); }
+    else { candidate.values.push_back(p.lower + u*(p.upper-p.lower)); }
+  }
+  return candidate;
+}
+
+// fastest of several solves in milliseconds, cone and storage are rebuilt outside of the timed region
+bool timeSolve(const DumpedProblem& problem, const SolverSetting& setting, int num_repeats, double& time, double& cost)
+{
+  time = SolverSetting::inf;
+  for (int repeat=0; repeat<num_repeats; repeat++) {
+    Cone cone;
+    SolverStorage storage;
+    SolverSetting solver_setting = setting;
+    problem.build(cone, storage, solver_setting);
+
+    InteriorPointSolver ip_solver;
+    auto start = std::chrono::steady_clock::now();
+    ip_solver.initialize(storage, cone, solver_setting);
+    ExitCode exit_code = ip_solver.optimize();
+    auto end = std::chrono::steady_clock::now();
+
+    if (exit_code != ExitCode::Optimal) { return false; }
+    time = std::min(time, std::chrono::duration<double, std::milli>(end-start).count());
+    const InteriorPointSolver& solved = ip_solver;
+    cost = problem.cost(solved.optimalVector().x());
+  }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc>1 && std::string(argv[1])=="--help") {
+    std::printf("usage: %s [problem_dir] [base_setting.yaml] [tuned_setting.yaml] [num_candidates] [num_repeats] [seed]\n", argv[0]);
+    return 0;
+  }
+
+  std::string problem_dir = argc>1 ? argv[1] : TEST_PATH;
+  std::string base_file = argc>2 ? argv[2] : TEST_PATH+std::string("default_stgs.yaml");
+  std::string output_file = argc>3 ? argv[3] : "tuned_setting.yaml";
+  int num_candidates = argc>4 ? std::atoi(argv[4]) : 32;
+  int num_repeats = argc>5 ? std::atoi(argv[5]) : 3;
+  std::mt19937 generator(argc>6 ? std::atoi(argv[6]) : 0);
+  const double cost_tolerance = 1.e-6;
+
+  SolverSetting base_setting;
+  base_setting.initialize(base_file);
+  base_setting.set(SolverBoolParam_Verbose, false);
+
+  // problems of the corpus, in a shuffled order so that early rungs see a mix of them
+  std::vector<std::string> files;
+  if (DIR* dir = opendir(problem_dir.c_str())) {
+    while (dirent* entry = readdir(dir)) {
+      std::string file = entry->d_name;
+      if (file.size()>5 && file.compare(file.size()-5, 5, ".yaml")==0) { files.push_back(problem_dir+"/"+file); }
+    }
+    closedir(dir);
+  }
+  std::sort(files.begin(), files.end());
+
+  // the base setting defines the reference costs, problems it does not solve are left out
+  Candidate base = baseCandidate(base_setting);
+  std::vector<DumpedProblem> problems;
+  std::vector<double> ref_costs;
+  for (const std::string& file : files) {
+    DumpedProblem problem;
+    if (!problem.load(file)) { continue; }
+
+    double time, cost;
+    if (!timeSolve(problem, base_setting, num_repeats, time, cost)) {
+      std::printf("skipping %s, not solved to optimality with the base setting\n", problem.name.c_str());
+      continue;
+    }
+    problems.push_back(problem);
+    ref_costs.push_back(cost);
+    base.times.push_back(time);
+  }
+  if (problems.empty()) { std::printf("no problems found in %s\n", problem_dir.c_str()); return 1; }
+
+  int num_problems = problems.size();
+  std::vector<int> order(num_problems);
+  for (int i=0; i<num_problems; i++) { order[i] = i; }
+  std::shuffle(order.begin(), order.end(), generator);
+  std::vector<double> base_times(num_problems);
+  for (int i=0; i<num_problems; i++) { base_times[i] = base.times[order[i]]; }
+  base.times = base_times;
+
+  // random search with successive halving: every rung keeps the faster half of the candidates
+  // that solved all problems seen so far accurately, and doubles the number of problems
+  std::vector<Candidate> candidates(1, base);
+  for (int i=1; i<num_candidates; i++) { candidates.push_back(randomCandidate(generator)); }
+
+  int num_rungs = std::ceil(std::log2(std::max(num_candidates, 2)));
+  int rung_problems = std::max(1, num_problems >> num_rungs);
+  for (int rung=0; ; rung++, rung_problems = std::min(2*rung_problems, num_problems)) {
+    for (Candidate& candidate : candidates) {
+      SolverSetting setting = base_setting;
+      candidate.apply(setting);
+      while (candidate.is_accurate && static_cast<int>(candidate.times.size())<rung_problems) {
+        int id = order[candidate.times.size()];
+        double time, cost;
+        candidate.is_accurate = timeSolve(problems[id], setting, num_repeats, time, cost) &&
+                                std::abs(cost-ref_costs[id]) <= cost_tolerance*std::max(1.0, std::abs(ref_costs[id]));
+        candidate.times.push_back(time);
+      }
+    }
+
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [](const Candidate& c) { return !c.is_accurate; }), candidates.end());
+    std::sort(candidates.begin(), candidates.end(), [rung_problems](const Candidate& a, const Candidate& b) { return a.totalTime(rung_problems) < b.totalTime(rung_problems); });
+    std::printf("rung %2d: %3d accurate candidates on %3d problems, fastest %10.3f ms\n", rung, static_cast<int>(candidates.size()),
+                rung_problems, candidates.empty() ? 0.0 : candidates.front().totalTime(rung_problems));
+
+    if (rung_problems==num_problems || candidates.empty()) { break; }
+    candidates.resize((candidates.size()+1)/2);
+  }
+
+  // candidates that were not evaluated on all problems cannot be chosen
+  Candidate best = base;
+  for (const Candidate& candidate : candidates)
+    if (static_cast<int>(candidate.times.size())==num_problems && candidate.totalTime(num_problems)<best.totalTime(num_problems)) { best = candidate; }
+
+  std::printf("\n%28s %14s %14s\n", "parameter", "base", "tuned");
+  for (int i=0; i<num_tuned_params; i++)
+    std::printf("%28s %14.6g %14.6g\n", tuned_params[i].key, base.values[i], best.values[i]);
+  std::printf("%28s %14.3f %14.3f\n", "total time [ms]", base.totalTime(num_problems), best.totalTime(num_problems));
+
+  // tuned values replace those of the base file, all other entries are kept
+  YAML::Node config = YAML::LoadFile(base_file);
+  for (int i=0; i<num_tuned_params; i++) {
+    if (tuned_params[i].is_int) { config["solver_variables"][tuned_params[i].key] = static_cast<int>(best.values[i]); }
+    else { config["solver_variables"][tuned_params[i].key] = best.values[i]; }
+  }
+  std::ofstream output(output_file);
+  output << config << "\n";
+  std::printf("\ntuned setting written to %s\n", output_file.c_str());
+
+  return 0;
+}
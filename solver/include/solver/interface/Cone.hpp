@@ -94,10 +94,11 @@ namespace solver {
 	  // Setting up problem
 	  void setupLpcone(int size);
 	  void setupSocone(const Eigen::VectorXi& indices);
-	  void initialize(int nvars, int nleq, int nlineq, const Eigen::VectorXi& nsoc);
+	  void initialize(int nvars, int nleq, int nlineq, const Eigen::VectorXi& nsoc, int nbox = 0);
 
 	  // Getter and setter methods for problem size variables
 	  inline const int numLeq() const { return neq_; }
+	  inline const int sizeBox() const { return nbox_; }
 	  inline const int numSoc() const { return nsoc_; }
 	  inline const int sizeSoc() const { return ssoc_; }
 	  inline const int sizeLpc() const { return nineq_; }
@@ -147,8 +148,8 @@ namespace solver {
 	  void conicDivision(const Eigen::Ref<const Eigen::VectorXd>& u, const Eigen::Ref<const Eigen::VectorXd>& w, Eigen::Ref<Eigen::VectorXd> v) const;
 	  double conicProduct(const Eigen::Ref<const Eigen::VectorXd> u, const Eigen::Ref<const Eigen::VectorXd> v, Eigen::Ref<Eigen::VectorXd> w) const;
 	  ConeStatus updateNTScalings(const Eigen::VectorXd& s, const Eigen::VectorXd& z, Eigen::VectorXd& lambda);
-	  void unpermuteSolution(const Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic>& Pinv, const Eigen::VectorXd& Px, OptimizationVector& sd) const;
-	  void unpermuteSolution(const Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic>& Pinv, const Eigen::VectorXd& Px, OptimizationVector& sd, Eigen::VectorXd& dz) const;
+	  void unpermuteSolution(const Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic>& Pinv, const Eigen::Ref<const Eigen::VectorXd>& Px, OptimizationVector& sd) const;
+	  void unpermuteSolution(const Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic>& Pinv, const Eigen::Ref<const Eigen::VectorXd>& Px, OptimizationVector& sd, Eigen::VectorXd& dz) const;
 
 	  // Getter and setter methods for scaling operators
 	  ScalingOperator& W() { return W_scaling_operator_; }
@@ -158,6 +159,7 @@ namespace solver {
 	  int nvars_;           // number variables
 	  int neq_;             // number linear equality constraints
 	  int nineq_;           // number linear inequality constraints
+	  int nbox_;            // number box constraints (leading entries of linear cone)
 	  int nsoc_;            // number second order cone constraints
 	  int ssoc_;            // size second order cone constraints
 	  int extssoc_;         // extended size second order cone constraints
@@ -388,17 +390,20 @@ namespace solver {
 
 	  Eigen::SparseMatrix<double>& Amatrix() { return A_; }
 	  Eigen::SparseMatrix<double>& Gmatrix() { return G_; }
-	  Eigen::SparseMatrix<double>& Atmatrix() { return At_; }
-	  Eigen::SparseMatrix<double>& Gtmatrix() { return Gt_; }
 	  const Eigen::SparseMatrix<double>& Amatrix() const { return A_; }
 	  const Eigen::SparseMatrix<double>& Gmatrix() const { return G_; }
-	  const Eigen::SparseMatrix<double>& Atmatrix() const { return At_; }
-	  const Eigen::SparseMatrix<double>& Gtmatrix() const { return Gt_; }
 
 	  void initializeMatrices();
 	  void initialize(Cone& cone, SolverSetting& stgs);
 	  void cleanCoeffs() { Acoeffs_.clear(); Gcoeffs_.clear(); }
+	  void assembleMatrix(const std::vector<Eigen::Triplet<double>>& coeffs, Eigen::SparseMatrix<double>& mat);
 	  void addCoeff(const Eigen::Triplet<double>& coeff, bool flag_eq = false);
+	  void addBoxCoeff(int row, int col, double value) { box_index_[row] = col; box_coeff_[row] = value; }
+
+	  Eigen::VectorXi& boxIndex() { return box_index_; }
+	  Eigen::VectorXd& boxCoeff() { return box_coeff_; }
+	  const Eigen::VectorXi& boxIndex() const { return box_index_; }
+	  const Eigen::VectorXd& boxCoeff() const { return box_coeff_; }
 
 	  Eigen::Ref<Eigen::VectorXd> cbh() { return cbh_; }
 	  Eigen::Ref<Eigen::VectorXd> c() { return cbh_.x(); }
@@ -431,7 +436,10 @@ namespace solver {
 	  Cone* cone_;
 	  SolverSetting* stgs_;
 	  Vector cbh_, cbh_copy_;
-	  Eigen::SparseMatrix<double> A_, At_, G_, Gt_;
+	  Eigen::VectorXi box_index_;
+	  Eigen::VectorXd box_coeff_;
+	  Eigen::SparseMatrix<double> A_, G_;
+	  std::vector<int> row_count_, col_count_, row_order_;
 	  std::vector<Eigen::Triplet<double>> Acoeffs_, Gcoeffs_;
 	  OptimizationVector u_opt_, v_opt_, u_t_opt_, u_prev_opt_;
   };
@@ -43,6 +43,7 @@ namespace solver {
       const int numTrustRegions() const { return numTrustRegions_; }
       const int numBinaryVariables() const { return bin_vars_.size(); }
       const int numSoftConstraints() const { return numSoftConstraints_; }
+      const OptimizationInfo& getInfo() const { return ip_solver_.getInfo(); }
 
     private:
       friend class Model;
@@ -55,6 +56,12 @@ namespace solver {
       ExitCode solveProblem();
       void buildProblem(int iter_id, bool warm_start = false);
 
+      // sequential convex programming over the nonconvex quadratic constraints
+      double stepNorm() const;
+      double objectiveValue() const;
+      void linearizeNonconvexConstraints();
+      void nonconvexViolation(double& violation, double& predicted_violation) const;
+
       // getter and setter methods
       Eigen::VectorXd& binaryLowerBounds() { return bin_vars_lower_bound_; }
       Eigen::VectorXd& binaryUpperBounds() { return bin_vars_upper_bound_; }
@@ -76,9 +83,18 @@ namespace solver {
 
       DCPQuadExpr objective_;
       int numTrustRegions_, numSoftConstraints_;
-      std::vector<LinExpr> leqcons_, lineqcons_;
+      std::vector<LinExpr> leqcons_, lineqcons_, boundcons_;
       std::vector<DCPQuadExpr> qineqcons_, soccons_;
       std::vector<std::shared_ptr<Var> > vars_, bin_vars_;
       Eigen::VectorXd bin_vars_lower_bound_, bin_vars_upper_bound_;
+
+      double scp_radius_;
+      std::vector<int> scp_cols_;
+      std::vector<double> scp_center_, scp_qvalues_;
+
+      // cone, solution and info of the last accepted solve, restored when a refinement is rejected
+      Cone scp_cone_;
+      OptimizationInfo scp_info_;
+      OptimizationVector scp_opt_;
   };
 }
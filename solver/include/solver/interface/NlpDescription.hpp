@@ -39,6 +39,25 @@ namespace solver
       // definition of constraints function
       virtual void evaluateConstraintsVector(int n_vars, int n_cons, const double* x, double* constraints) = 0;
 
+      // optional analytic gradient of objective function, otherwise finite differences are used
+      virtual bool hasObjectiveGradient() const { return false; }
+      virtual void evaluateObjectiveGradient(int n_vars, const double* x, double* gradient) {}
+
+      // optional analytic jacobian of constraints function, given by the row and column of each
+      // nonzero entry; the default structure is a dense jacobian stored row after row
+      virtual bool hasConstraintsJacobian() const { return false; }
+      virtual int getJacobianNonZeros(int n_vars, int n_cons) { return n_vars*n_cons; }
+      virtual void getJacobianStructure(int n_vars, int n_cons, int* rows, int* cols)
+      {
+        for (int row=0, id=0; row<n_cons; row++)
+          for (int col=0; col<n_vars; col++, id++) { rows[id] = row;  cols[id] = col; }
+      }
+      virtual void evaluateConstraintsJacobian(int n_vars, int n_cons, const double* x, double* values) {}
+
+      // problems whose objective and constraints functions can be evaluated concurrently
+      // at different points allow finite differences to be computed in parallel
+      virtual bool isThreadSafe() const { return false; }
+
       // definition of how to process solution
       virtual void processSolution(int n_vars, double objective_value, const double* x)
       {
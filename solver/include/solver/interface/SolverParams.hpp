@@ -20,6 +20,12 @@ namespace solver {
 
 	// Linear System parameters
 	SolverIntParam_NumIterRefinementsLinSolve,
+	SolverIntParam_KktOrdering,                 // 0: approximate minimum degree, 1: nested dissection
+	SolverIntParam_DenseKktThreshold,           // kkt matrices up to this size are factorized in dense storage
+	SolverIntParam_DenseSocThreshold,           // second order cones up to this size enter the kkt matrix densely, without lifting
+
+	// Algorithm parameters
+	SolverIntParam_MaxCentralityCorrectors,     // gondzio correctors per iteration, reusing the factorization
 
 	// Model parameters
 	SolverIntParam_MaxIters,
@@ -27,6 +33,9 @@ namespace solver {
     SolverIntParam_SolverMaxIters,
 	SolverIntParam_NumberRefinementsTrustRegion,
 
+	// Augmented Lagrangian parameters
+	SolverIntParam_AugLagMaxIters,              // outer iterations of the augmented lagrangian in LbfgsSolver
+
 	// Variable parameters
     SolverIntParam_ColNum,
 
@@ -35,6 +44,7 @@ namespace solver {
 	SolverIntParam_NumRefsLinSolve,
 	SolverIntParam_NumRefsLinSolveAffine,
 	SolverIntParam_NumRefsLinSolveCorrector,
+	SolverIntParam_NumScpRefinements,
   };
 
   /*! Available boolean variables used by the optimizer */
@@ -72,11 +82,22 @@ namespace solver {
 	SolverDoubleParam_StepLengthScaling,
 	SolverDoubleParam_MinimumCenteringStep,
 	SolverDoubleParam_MaximumCenteringStep,
+	SolverDoubleParam_CorrectorStepIncrease,        // relative increase of the step length a corrector aims at
+	SolverDoubleParam_CorrectorAcceptance,          // fraction of that increase required to keep a corrector
 
 	// Model parameters
 	SolverDoubleParam_TrustRegionThreshold,
 	SolverDoubleParam_SoftConstraintWeightFull,
 	SolverDoubleParam_SoftConstraintWeightReduced,
+	SolverDoubleParam_ScpInitialRadius,             // trust region on the variables of nonconvex terms, infinite leaves them free
+	SolverDoubleParam_ScpStepTolerance,             // refinements do not stop while the linearization point moves more than this
+	SolverDoubleParam_ScpViolationTolerance,        // nor stop while the nonconvex constraints are violated by more than this
+
+	// Augmented Lagrangian parameters
+	SolverDoubleParam_AugLagFeasibilityTol,         // maximum constraint violation at convergence
+	SolverDoubleParam_AugLagOptimalityTol,          // tolerance on the gradient of the inner solves
+	SolverDoubleParam_AugLagInitialPenalty,         // penalty weight of the first outer iteration
+	SolverDoubleParam_AugLagPenaltyGrowth,          // penalty increase when the violation decreases too slowly
 
 	// Variable parameters
     SolverDoubleParam_X,
@@ -101,6 +122,13 @@ namespace solver {
 	SolverDoubleParam_StepLength,
 	SolverDoubleParam_AffineStepLength,
 	SolverDoubleParam_CorrectionStepLength,
+	SolverDoubleParam_NonconvexViolation,
+  };
+
+  /*! Available string variables used by the optimizer */
+  enum SolverStringParam {
+	// Linear System parameters
+	SolverStringParam_OrderingCacheDir
   };
 
 }
@@ -36,6 +36,7 @@ namespace solver {
   enum class FactStatus { Optimal, Failure };
   enum class PrecisionConvergence { Full, Reduced };
   enum class QuadConstrApprox { None, TrustRegion, SoftConstraint  };
+  enum class KktOrdering { Amd = 0, NestedDissection = 1 };
 
   /**
    * Class that provides access to all environment variables required by the solver
@@ -51,10 +52,12 @@ namespace solver {
       int get(SolverIntParam param) const;
       bool get(SolverBoolParam param) const;
       double get(SolverDoubleParam param) const;
+      const std::string& get(SolverStringParam param) const;
 
       void set(SolverIntParam param, int value);
       void set(SolverBoolParam param, bool value);
       void set(SolverDoubleParam param, double value);
+      void set(SolverStringParam param, const std::string& value);
 
 	  static constexpr double nan = ((double)0x7ff8000000000000);
 	  static constexpr double inf = ((double)std::numeric_limits<double>::infinity());
@@ -73,16 +76,24 @@ namespace solver {
 	  int equil_iterations_;
 
 	  // Linear System parameters
-	  int num_iter_ref_lin_solve_;
+	  int num_iter_ref_lin_solve_, kkt_ordering_, dense_kkt_threshold_, dense_soc_threshold_;
 	  double dyn_reg_thresh_, lin_sys_accuracy_, err_reduction_factor_, static_regularization_, dynamic_regularization_;
+	  std::string ordering_cache_dir_;
 
 	  // Algorithm parameters
 	  double safeguard_, min_step_length_, max_step_length_, min_centering_step_, max_centering_step_, step_length_scaling_;
+	  int max_centrality_correctors_;
+	  double corrector_step_increase_, corrector_acceptance_;
 
 	  // Model parameters
 	  bool verbose_;
 	  double trust_region_threshold_, soft_constraint_weight_full_, soft_constraint_weight_reduced_;
+	  double scp_initial_radius_, scp_step_tolerance_, scp_violation_tolerance_;
 	  int max_iters_, num_itrefs_trustregion_, ipsolver_warm_iters_, ipsolver_max_iters_;
+
+	  // Augmented Lagrangian parameters
+	  int al_max_iters_;
+	  double al_feasibility_tolerance_, al_optimality_tolerance_, al_initial_penalty_, al_penalty_growth_;
   };
 
 }
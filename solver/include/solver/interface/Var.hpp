@@ -13,7 +13,7 @@
 
 namespace rt_solver {
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks = 7>
   class RtModel;
 
 }
@@ -46,7 +46,7 @@ namespace solver {
       friend class LinExpr;
       friend class ConicProblem;
 
-      template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
+      template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
       friend class rt_solver::RtModel;
 
     private:
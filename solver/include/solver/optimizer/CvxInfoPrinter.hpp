@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <solver/interface/SolverSetting.hpp>
+#include <solver/optimizer/OutputSink.hpp>
 
 namespace solver {
 
@@ -35,7 +36,7 @@ namespace solver {
   class OptimizationInfo
   {
     public:
-      OptimizationInfo() : iteration_(-1){}
+      OptimizationInfo() : iteration_(-1), scp_refinements_(0), nonconvex_violation_(0.0){}
       ~OptimizationInfo(){}
 
       bool isBetterThan(const OptimizationInfo& info) const;
@@ -51,22 +52,30 @@ namespace solver {
 
     private:
       PrecisionConvergence mode_;
-      int iteration_, linear_solve_refinements_, affine_linear_solve_refinements_, correction_linear_solve_refinements_;
+      int iteration_, linear_solve_refinements_, affine_linear_solve_refinements_, correction_linear_solve_refinements_, scp_refinements_;
       double primal_cost_, dual_cost_, primal_residual_, dual_residual_, primal_infeasibility_, dual_infeasibility_,
              tau_, kappa_, kappa_over_tau_, merit_function_, duality_gap_, relative_duality_gap_, correction_step_length_,
-             step_length_, affine_step_length;
+             step_length_, affine_step_length, nonconvex_violation_;
   };
 
+  /**
+   * Class that formats the messages of the interior point solver into the
+   * output sink of the solver instance, which is drained after optimization.
+   */
   class CvxInfoPrinter
   {
     public:
       CvxInfoPrinter(){}
       ~CvxInfoPrinter(){}
 
-      void initialize(const SolverSetting& stgs) { stgs_ = std::make_shared<SolverSetting>(stgs); }
+      void initialize(const std::shared_ptr<const SolverSetting>& stgs);
       void display(const Msg& msg, const OptimizationInfo& info);
 
+      OutputSink& sink() { return sink_; }
+      const OutputSink& sink() const { return sink_; }
+
     private:
-      std::shared_ptr<SolverSetting> stgs_;
+      OutputSink sink_;
+      std::shared_ptr<const SolverSetting> stgs_;
   };
 }
@@ -0,0 +1,47 @@
+/**
+ * @file DenseCholesky.hpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <solver/interface/SolverSetting.hpp>
+
+namespace linalg {
+
+  /**
+   * Class to perform an LDL factorization of a small matrix in dense storage,
+   * with the same dynamic regularization as SparseCholesky. For kkt matrices
+   * of a dozen or so rows, ordering and symbolic analysis cost more than the
+   * arithmetic they save; beyond that the sparse factorization wins, as kkt
+   * matrices rarely fill in. The upper triangle of the matrix is read from
+   * its compressed columns.
+   */
+  class DenseCholesky
+  {
+    public:
+      DenseCholesky(){}
+      ~DenseCholesky(){}
+
+      void analyzePattern(const Eigen::SparseMatrix<double>& mat, const solver::SolverSetting& stgs);
+      int  factorize(const Eigen::SparseMatrix<double>& mat, const Eigen::Ref<const Eigen::VectorXd>& sign);
+      void solve(const Eigen::Ref<const Eigen::VectorXd>& b, double* x);
+      void solve(Eigen::Ref<Eigen::MatrixXd> x);
+
+      // fill and operation count of the factor
+      int factorNonZeros() const { return n_*(n_-1)/2; }
+      double factorFlops() const;
+
+    private:
+      int n_;
+      double eps_, delta_;
+      Eigen::MatrixXd L_;
+      Eigen::VectorXd D_;
+  };
+
+}
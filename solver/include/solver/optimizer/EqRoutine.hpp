@@ -36,15 +36,17 @@ namespace solver {
       const Vector& equilVec() const { return equil_vec_; }
 
     private:
-	  void ruizEquilibration(SolverStorage& stg);
+	  void ruizEquilibration(SolverStorage& stg, int num_iters);
 	  void maxRowsCols(double *row_vec, double *col_vec, const Eigen::SparseMatrix<double>& mat);
+	  void maxBoxRowsCols(double *row_vec, double *col_vec, const SolverStorage& stg);
+	  void equilibrateBox(const double *row_vec, const double *col_vec, SolverStorage& stg);
+	  void unequilibrateBox(const double *row_vec, const double *col_vec, SolverStorage& stg);
 	  void equilibrateRowsCols(const double *row_vec, const double *col_vec, Eigen::SparseMatrix<double>& mat);
 	  void unequilibrateRowsCols(const double *row_vec, const double *col_vec, Eigen::SparseMatrix<double>& mat);
 
     private:
 	  Vector equil_vec_;
 	  std::shared_ptr<Cone> cone_;
-	  std::shared_ptr<SolverSetting> stgs_;
   };
 
 }
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <memory>
 #include <solver/interface/Cone.hpp>
 #include <solver/optimizer/LinSolver.hpp>
 #include <solver/optimizer/EqRoutine.hpp>
@@ -27,6 +28,13 @@ namespace solver {
    * Main class that implements an Interior Point Solver for Second-Order Cones.
    * Details can be found in the paper: Domahidi, A. and Chu, E. and Boyd, S.,
    *     ECOS: An SOCP solver for embedded systems, ECC 2013, pages 3071-3076
+   * Optionally, Gondzio's multiple centrality correctors refine the combined
+   * direction with extra solves using the same factorization, see
+   *     Gondzio, J., Multiple centrality corrections in a primal-dual method
+   *     for linear programming, Comput. Optim. Appl. 6 (1996), pages 137-156
+   * The setting is copied once per initialization into an immutable snapshot
+   * shared by all components, and messages are written into a sink owned by
+   * the instance, so that solvers on different threads do not interfere.
    */
   class InteriorPointSolver
   {
@@ -36,13 +44,14 @@ namespace solver {
 
       ExitCode optimize();
       const OptimizationVector& optimalVector() const { return opt_; }
-      void initialize(SolverStorage& stg, Cone& cone, SolverSetting& stgs);
+      const OptimizationInfo& getInfo() const { return optimization_info_; }
+      void initialize(SolverStorage& stg, Cone& cone, const SolverSetting& stgs);
       int current_iter;
 
     private:
       inline Cone& getCone() { return *cone_; }
       inline SolverStorage& getStorage() { return *storage_; }
-      inline SolverSetting& getSetting() { return *setting_; }
+      inline const SolverSetting& getSetting() const { return *setting_; }
       inline CvxInfoPrinter& getPrinter() { return printer_; }
       inline OptimizationVector& optimalVector() { return opt_; }
       inline LinSolver& getLinSolver() { return linear_solver_; }
@@ -50,6 +59,7 @@ namespace solver {
       inline EqRoutine& getEqRoutine() { return equilibration_routine_; }
       inline OptimizationInfo& getBestInfo() { return best_optimization_info_; }
 
+      ExitCode iterate();
       void rhsAffineStep();
       void computeResiduals();
       void updateStatistics();
@@ -57,7 +67,9 @@ namespace solver {
       void restoreBestIterate();
       void internalInitialization();
       ExitCode initializeVariables();
-      void rhsCenteringPredictorStep();
+      void rhsCenteringPredictorStep(bool scale_residuals = true);
+      double combinedStep(bool is_corrector);
+      double centralityCorrectors(double step_length);
       void updateEquilH(int id, double value);
       ExitCode convergenceCheck(const PrecisionConvergence& mode);
       double lineSearch(const Eigen::Ref<const Eigen::VectorXd>& dsvec,
@@ -73,14 +85,14 @@ namespace solver {
       Vector res_;
       ExitCode exitcode_;
       ExtendedVector rhs1_, rhs2_;
-      OptimizationVector opt_, best_opt_, dopt1_, dopt2_;
-      ConicVector lambda_, rho_, sigma_, lbar_, ds_affine_by_W_, W_times_dz_affine_, ds_combined_, dz_combined_;
+      OptimizationVector opt_, best_opt_, dopt1_, dopt2_, dopt3_;
+      ConicVector lambda_, rho_, sigma_, lbar_, ds_affine_by_W_, W_times_dz_affine_, ds_combined_, dz_combined_, ds_prev_by_W_, W_times_dz_prev_;
       double dk_combined_, dt_affine_, dk_affine_, inires_x_, inires_y_, inires_z_, dt_denom_,
              residual_t_, residual_x_, residual_y_, residual_z_, cx_, by_, hz_, prev_pres_;
 
       Cone* cone_;
       SolverStorage* storage_;
-      SolverSetting* setting_;
+      std::shared_ptr<const SolverSetting> setting_;
       CvxInfoPrinter printer_;
       LinSolver linear_solver_;
       EqRoutine equilibration_routine_;
@@ -31,9 +31,12 @@
 
 #pragma once
 
+#include <vector>
 #include <iostream>
 #include <Eigen/Dense>
+#include <boost/thread.hpp>
 #include <solver/interface/NlpDescription.hpp>
+#include <solver/interface/SolverSetting.hpp>
 
 namespace solver {
   /**
@@ -385,6 +388,38 @@ namespace solver {
     lbfgs_evaluate_t proc_evaluate, lbfgs_progress_t proc_progress,
     void *instance, lbfgs_parameter_t *param);
 
+  /**
+   * Correction pairs of L-BFGS-B, kept between calls to warm start a sequence
+   * of related minimizations such as the inner solves of an augmented Lagrangian.
+   */
+  typedef struct {
+    int num_pairs, end;
+    double theta;
+    Eigen::MatrixXd s, y;
+  } lbfgsb_memory_t;
+
+  /**
+   * Start a L-BFGS-B optimization with variables restricted to a box.
+   *
+   *  Bounds are handled exactly: each iteration computes the generalized
+   *  Cauchy point along the projected gradient path, minimizes the compact
+   *  limited memory model over the variables that are free at that point and
+   *  searches along the resulting feasible direction with a projected
+   *  backtracking line search. Convergence is tested on the projected
+   *  gradient. Arguments are as for lbfgs(), with the additional ones below.
+   *
+   *  @param  lower       The array of lower bounds, entries can be -infinity.
+   *  @param  upper       The array of upper bounds, entries can be infinity.
+   *  @param  memory      The correction pairs to start from and to store on
+   *                      exit. This argument can be set to \c NULL.
+   *  @retval int         The status code. This function returns zero if the
+   *                      minimization process terminates without an error. A
+   *                      non-zero value indicates an error.
+   */
+  int lbfgsb(int n, double *x, double *ptr_fx, const double *lower, const double *upper,
+    lbfgs_evaluate_t proc_evaluate, lbfgs_progress_t proc_progress,
+    void *instance, lbfgs_parameter_t *param, lbfgsb_memory_t *memory = NULL);
+
   /**
    * Initialize L-BFGS parameters to the default values.
    *
@@ -423,31 +458,70 @@ namespace solver {
   {
     public:
 	  LbfgsSolver();
-      virtual ~LbfgsSolver(){}
+      virtual ~LbfgsSolver(){ this->stop_workers(); }
 
       bool initialize(NlpDescription* nlproblem, double constraints_weight = 1.);
+      bool initialize(NlpDescription* nlproblem, const SolverSetting& setting);
       void optimize();
 
       bool& verbose() { return verbose_; }
+      int& num_threads() { return num_threads_; }
+      bool& exact_bounds() { return exact_bounds_; }
       lbfgs_parameter_t& opt_params() { return opt_params_; }
 
     private:
       // definition of cost evaluation
       static double delegate_evaluate(void *instance, const double *x, double *g, const int n, const double step );
       double evaluate(void *instance, const double *x, double *g, const int n, const double step );
-      double evaluate_objective_function(const double* eig_x);
+      struct Workspace
+      {
+        void resize(int nvars, int ncons) { pert_x.resize(nvars);  cons.resize(ncons);  x_violation.resize(nvars);  cons_violation.resize(ncons); }
+        Eigen::VectorXd pert_x, cons, x_violation, cons_violation;
+      };
+
+      double evaluate_objective_function(const double* eig_x, Workspace& workspace);
+      double evaluate_objective_and_gradient(const double* x, double* g);
+      void optimize_augmented_lagrangian();
+      void finite_differences(int worker, const double* x, double* g);
+      double penalty(const Eigen::Ref<const Eigen::VectorXd>& val, const Eigen::VectorXd& lower, const Eigen::VectorXd& upper, Eigen::VectorXd& violation) const;
 
       // definition of how to show progress of the optimization
       static int delegate_progress(void *instance, const double *x, const double *g, const double fx, const double xnorm,
   		                           const double gnorm, const double step, int n, int k, int ls );
       int progress(const double *x, const double *g, double fx, double xnorm, double gnorm, int n, int k );
 
+      // definition of the workers sharing the finite differences
+      void start_workers(int num_workers);
+      void stop_workers();
+      void worker_loop(int worker, int generation);
+
     private:
       NlpDescription* nlproblem_;
       double constraints_weight_;
-      bool verbose_, initialized_;
+      bool verbose_, initialized_, analytic_gradient_, exact_bounds_, augmented_lagrangian_;
       lbfgs_parameter_t opt_params_;
       int nvars_, ncons_, *user_info_, opt_status_, length_of_address_to_this_;
+      Eigen::VectorXi jac_rows_, jac_cols_;
+      Eigen::VectorXd jac_values_;
+
+      // bounds are fixed during a solve, workspaces avoid allocations per evaluation
+      Eigen::VectorXd x_l_, x_u_, g_l_, g_u_;
+      std::vector<Workspace> workspaces_;
+
+      // augmented lagrangian shifts the bounds by the multipliers divided by the penalty
+      int al_max_iters_;
+      double al_feasibility_tolerance_, al_optimality_tolerance_, al_initial_penalty_, al_penalty_growth_;
+      Eigen::VectorXd x_shift_, cons_shift_;
+      lbfgsb_memory_t al_memory_;
+
+      // worker threads, each one perturbs its own subset of coordinates
+      int num_threads_, pool_generation_, pool_pending_;
+      bool pool_stop_;
+      const double* pool_x_;
+      double* pool_g_;
+      boost::thread_group workers_;
+      boost::mutex pool_mutex_;
+      boost::condition_variable work_cond_, done_cond_;
   };
 
 }
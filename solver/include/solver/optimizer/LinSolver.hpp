@@ -11,17 +11,21 @@
 
 #pragma once
 
+#include <memory>
 #include <solver/interface/Cone.hpp>
 #include <solver/interface/SolverSetting.hpp>
+#include <solver/optimizer/OrderingCache.hpp>
+#include <solver/optimizer/DenseCholesky.hpp>
+#include <solver/optimizer/NestedDissection.hpp>
 #include <solver/optimizer/SparseCholesky.hpp>
 
 namespace solver {
 
   /**
    * Class that provides functionality for handling solution of linear systems
-   * in optimization problems. Performs symbolic and numeric factorization of
-   * kkt matrix, find permutation of kkt matrix to induce the best possible
-   * sparsity pattern, builds and updates kkt matrix and its scalings as required.
+   * in optimization problems. Finds a fill-reducing permutation of the kkt
+   * matrix, performs its symbolic and numeric factorization (dense for small
+   * matrices), builds and updates the kkt matrix and its scalings as required.
    */
   class LinSolver
   {
@@ -32,11 +36,22 @@ namespace solver {
       void updateMatrix();
       void initializeMatrix();
       FactStatus numericFactorization();
-      void initialize(Cone& cone, SolverSetting& stgs, SolverStorage& stg);
-      int solve(const Eigen::Ref<const Eigen::VectorXd>& permB, OptimizationVector& searchDir, bool is_initialization = false);
+      void initialize(Cone& cone, const SolverSetting& stgs, SolverStorage& stg);
+      void initialize(Cone& cone, const std::shared_ptr<const SolverSetting>& stgs, SolverStorage& stg);
+      int solve(const Eigen::Ref<const Eigen::VectorXd>& permB, OptimizationVector& searchDir);
+      void solve(const Eigen::Ref<const Eigen::VectorXd>& permB1, OptimizationVector& searchDir1, int& numRefs1,
+                 const Eigen::Ref<const Eigen::VectorXd>& permB2, OptimizationVector& searchDir2, int& numRefs2);
+      void matrixTimesVector(const Eigen::SparseMatrix<double>& A,const Eigen::Ref<const Eigen::VectorXd>& eig_x, Eigen::Ref<Eigen::VectorXd> eig_y, bool add = true, bool is_new = true);
       void matrixTransposeTimesVector(const Eigen::SparseMatrix<double>& A,const Eigen::Ref<const Eigen::VectorXd>& eig_x, Eigen::Ref<Eigen::VectorXd> eig_y, bool add = true, bool is_new = true);
+      void boxTimesVector(const Eigen::Ref<const Eigen::VectorXd>& eig_x, Eigen::Ref<Eigen::VectorXd> eig_y, bool add = true);
+      void boxTransposeTimesVector(const Eigen::Ref<const Eigen::VectorXd>& eig_z, Eigen::Ref<Eigen::VectorXd> eig_y, bool add = true);
 
       // Some getter and setter methods
+      int kktNonZeros() const { return permKkt_.nonZeros(); }
+      bool isDense() const { return is_dense_; }
+      int factorNonZeros() const { return is_dense_ ? dense_cholesky_.factorNonZeros() : cholesky_.factorNonZeros(); }
+      double factorFlops() const { return is_dense_ ? dense_cholesky_.factorFlops() : cholesky_.factorFlops(); }
+      int eliminationTreeHeight() const { return is_dense_ ? kkt_.cols() : cholesky_.eliminationTreeHeight(); }
       int perm(int id) { return perm_.indices()[id]; }
       int invPerm(int id) { return invPerm_.indices()[id]; }
       Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic>& perm() { return perm_; }
@@ -47,25 +62,41 @@ namespace solver {
     private:
       inline Cone& getCone() { return *cone_; }
       inline SolverStorage& getStorage() { return *storage_; }
-      inline SolverSetting& getSetting() { return *setting_; }
+      inline const SolverSetting& getSetting() const { return *setting_; }
       inline linalg::SparseCholesky& getCholesky() { return cholesky_; }
+      inline bool isCompactSoc(int l) { return this->getCone().sizeSoc(l) <= this->getSetting().get(SolverIntParam_DenseSocThreshold); }
+      inline int numSocIndices(int l) { int q = this->getCone().sizeSoc(l); return this->isCompactSoc(l) ? q*(q+1)/2 : 3*q+1; }
 
       void buildProblem();
-      void findPermutation();
+      void findPermutation(bool use_cache = true);
+      void permuteMatrix();
       void resizeProblemData();
       void symbolicFactorization();
+      void updateBoxScalings();
+      void solveKkt(Eigen::Ref<Eigen::MatrixXd> permX);
+      void solveBlock(const Eigen::Ref<const Eigen::MatrixXd>& permB, OptimizationVector** searchDirs, int* numRefs);
+      void condenseBoxRows(const Eigen::Ref<const Eigen::MatrixXd>& permB, Eigen::Ref<Eigen::MatrixXd> permBkkt);
+      void recoverBoxRows(const Eigen::Ref<const Eigen::MatrixXd>& permB, Eigen::Ref<Eigen::MatrixXd> permX);
+      double kktResidual(const Eigen::Ref<const Eigen::VectorXd>& permB, const Eigen::Ref<const Eigen::VectorXd>& permX, Eigen::Ref<Eigen::VectorXd> permE);
+
+      // maximum number of right hand sides solved together
+      static const int Max_Rhs = 2;
 
     private:
       Cone* cone_;
       SolverStorage* storage_;
-      SolverSetting* setting_;
+      std::shared_ptr<const SolverSetting> setting_;
       linalg::SparseCholesky cholesky_;
+      linalg::DenseCholesky dense_cholesky_;
+      linalg::OrderingCache ordering_cache_;
+      bool is_cached_ordering_, is_dense_, is_initial_matrix_;
 
-      ConicVector Gdx_;
       double static_regularization_;
-      ExtendedVector sign_, permSign_;
-      Eigen::VectorXd permX_, Pe_, permdX_;
+      ExtendedVector sign_;
+      Eigen::VectorXi xDiagIndex_, permK_;
+      Eigen::VectorXd permSign_, boxDiag_;
+      Eigen::MatrixXd permB_, permBkkt_, permX_, Pe_, permdX_;
       Eigen::SparseMatrix<double> kkt_, permKkt_;
-      Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic> perm_, invPerm_, permK_;
+      Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic> perm_, invPerm_, kktInvPerm_;
   };
 }
@@ -0,0 +1,47 @@
+/**
+ * @file NestedDissection.hpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <vector>
+#include <Eigen/Sparse>
+
+namespace linalg {
+
+  /**
+   * Fill-reducing ordering by nested dissection of the graph of a symmetric
+   * matrix. Subgraphs are recursively split by level-structure separators
+   * rooted at a pseudo-peripheral node, which keeps fill bounded on long,
+   * chain-like systems such as trajectory optimization problems. Connected
+   * components are dissected separately and subgraphs below a leaf size are
+   * ordered by approximate minimum degree.
+   * Follows the interface of Eigen::AMDOrdering: perm.indices()[new] = old.
+   */
+  class NestedDissectionOrdering
+  {
+    public:
+      typedef Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> PermutationType;
+
+      NestedDissectionOrdering(int leaf_size = 64) : leaf_size_(leaf_size) {}
+      ~NestedDissectionOrdering(){}
+
+      void operator()(const Eigen::SparseMatrix<double>& mat, PermutationType& perm);
+
+    private:
+      void buildGraph(const Eigen::SparseMatrix<double>& mat);
+      void dissect(const std::vector<int>& nodes);
+      void dissectComponent(const std::vector<int>& nodes);
+      void orderLeaf(const std::vector<int>& nodes);
+      int levelStructure(int root, int label, std::vector<int>& visited);
+
+    private:
+      int leaf_size_, num_labels_;
+      std::vector<int> xadj_, adj_, label_, level_, local_, order_;
+  };
+
+}
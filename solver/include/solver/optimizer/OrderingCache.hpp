@@ -0,0 +1,50 @@
+/**
+ * @file OrderingCache.hpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <Eigen/Sparse>
+
+namespace linalg {
+
+  /**
+   * Class that stores fill-reducing orderings of a sparse matrix together with
+   * the elimination tree and column counts of its factor in a local directory.
+   * Entries are keyed by a structural hash of the matrix pattern and the
+   * ordering method, so that processes solving problems with the same
+   * structure can skip the ordering. The stored elimination tree is checked
+   * against the recomputed one to detect entries of a different pattern.
+   */
+  class OrderingCache
+  {
+    public:
+      OrderingCache(){}
+      ~OrderingCache(){}
+
+      bool load(const std::string& dir, const Eigen::SparseMatrix<double>& mat, int ordering);
+      bool save(const std::string& dir, const Eigen::SparseMatrix<double>& mat, int ordering, const Eigen::VectorXi& perm,
+                const Eigen::VectorXi& parent, const Eigen::VectorXi& lnnz) const;
+
+      static std::uint64_t patternHash(const Eigen::SparseMatrix<double>& mat);
+
+      // Some getter methods
+      const Eigen::VectorXi& perm() const { return perm_; }
+      const Eigen::VectorXi& parent() const { return parent_; }
+      const Eigen::VectorXi& lnnz() const { return lnnz_; }
+
+    private:
+      bool isValid(int n) const;
+      std::string fileName(const std::string& dir, std::uint64_t hash, int ordering) const;
+
+    private:
+      Eigen::VectorXi perm_, parent_, lnnz_;
+  };
+
+}
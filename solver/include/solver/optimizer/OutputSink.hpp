@@ -0,0 +1,50 @@
+/**
+ * @file OutputSink.hpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <ostream>
+
+namespace solver {
+
+  /**
+   * Class that buffers the text output of one solver instance in a ring of
+   * fixed-size lines, so that iterations only format into preallocated memory
+   * and never lock a shared stream. One thread writes and one thread drains
+   * the lines into a stream; neither of them blocks. Lines written while the
+   * ring is full are dropped and counted. The ring is sized by reserve, which
+   * must not run concurrently with write or drain.
+   */
+  class OutputSink
+  {
+    public:
+      OutputSink() : capacity_(0), head_(0), tail_(0), dropped_(0) {}
+      OutputSink(const OutputSink& other) : OutputSink() { this->reserve(other.capacity_); }
+      OutputSink& operator=(const OutputSink& other) { if (this!=&other) { this->reserve(other.capacity_); } return *this; }
+      ~OutputSink(){}
+
+      void reserve(int num_lines);
+      bool write(const char* format, ...) __attribute__((format(printf, 2, 3)));
+      int drain(std::ostream& stream);
+
+      // Some getter methods
+      int capacity() const { return capacity_; }
+      long droppedLines() const { return dropped_.load(std::memory_order_relaxed); }
+
+      // longer lines are truncated
+      static const int Line_Size = 256;
+
+    private:
+      int capacity_;
+      std::vector<char> lines_;
+      std::atomic<long> head_, tail_, dropped_;
+  };
+
+}
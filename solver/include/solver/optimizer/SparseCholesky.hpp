@@ -46,7 +46,6 @@
 
 #pragma once
 
-#include <memory>
 #include <Eigen/Sparse>
 #include <solver/interface/SolverSetting.hpp>
 
@@ -64,17 +63,27 @@ namespace linalg {
 	  void analyzePattern(const Eigen::SparseMatrix<double>& mat, const solver::SolverSetting& stgs);
 	  int  factorize(const Eigen::SparseMatrix<double>& mat, const Eigen::Ref<const Eigen::VectorXd>& sign);
 	  void solve(const Eigen::Ref<const Eigen::VectorXd>& b, double* x);
+	  void solve(Eigen::Ref<Eigen::MatrixXd> x);
 	  Eigen::VectorXd& solve(const Eigen::VectorXd& b);
 
+	  // elimination tree and column counts, valid between analyzePattern and factorize
+	  const Eigen::VectorXi& parent() const { return Parent_; }
+	  const Eigen::VectorXi& lnnz() const { return Lnnz_; }
+
+	  // fill, operation count and elimination tree height of the factor
+	  int factorNonZeros() const { return L_.nonZeros(); }
+	  double factorFlops() const;
+	  int eliminationTreeHeight() const;
+
     private:
-      inline const solver::SolverSetting& getSetting() const { return *setting_; }
+      void allocateFactor();
+      void resize(const Eigen::SparseMatrix<double>& mat, const solver::SolverSetting& stgs);
 
 	  int n_;
 	  double eps_, delta_;
 	  Eigen::VectorXd D_, Y_, X_;
 	  Eigen::SparseMatrix<double> L_;
 	  Eigen::VectorXi Parent_, Pattern_, Flag_, Lnnz_;
-	  std::shared_ptr<const solver::SolverSetting> setting_;
 
   };
 
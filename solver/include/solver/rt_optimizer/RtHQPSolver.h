@@ -14,89 +14,149 @@
 namespace rt_solver {
 
   // helper variable to define max number of ranks possible in the hierarchy
-  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows>
-  const int RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows>::num_max_ranks_;
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
+  const int RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::num_max_ranks_;
 
   // constructor and destructor
-  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows>
-  RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows>::RtHQPSolver(YAML::Node params)
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
+  RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::RtHQPSolver(YAML::Node params)
     : qp_solver_(), qp_solver_interface_(qp_solver_)
   {
     reset(Max_Num_Vars);
+    stop_svd2problem_converter_ = false;
     inequality_relaxation_ = (params["ineq_relax"] ? params["ineq_relax"].as<double>() : 1.e-6);
     eq_condition_threash_ = (params["hsol_max_eq_cond"] ? params["hsol_max_eq_cond"].as<double>() : 1.e8);
     diag_addition_for_psd_hessian_ = (params["psd_hessian_diag"] ? params["psd_hessian_diag"].as<double>() : 1.e-8);
+    use_qr_nullspace_ = (params["nullspace_qr"] ? params["nullspace_qr"].as<bool>() : false);
+    reuse_factorizations_ = (params["reuse_factorizations"] ? params["reuse_factorizations"].as<bool>() : true);
+    qp_solver_interface_.warmStart() = (params["qp_warm_start"] ? params["qp_warm_start"].as<bool>() : false);
+    svd_inline_size_ = (params["svd_inline_size"] ? params["svd_inline_size"].as<int>() : 0);
+    svd_thread_cpu_ = (params["svd_thread_cpu"] ? params["svd_thread_cpu"].as<int>() : -1);
+    svd_thread_priority_ = (params["svd_thread_priority"] ? params["svd_thread_priority"].as<int>() : 0);
+    problem2svd_converter_.spin_count_ = svd2problem_converter_.spin_count_ =
+      (params["svd_spin_count"] ? params["svd_spin_count"].as<int>() : 10000);
+
+    for (int task=0; task<num_max_ranks_; task++) {
+      task_dim_qp_[task] = task_num_ineq_[task] = 0;
+      RtVectorUtils::resize(task_active_set_[task], 0);
+    }
   }
 
-  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows>
-  RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows>::~RtHQPSolver()
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
+  RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::~RtHQPSolver()
   {
     stopSVD2ProblemConverter();
   }
 
   // initialization function
-  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows>
-  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows>::initialize()
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
+  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::initialize()
   {
-    is_svd_computed_ = true;
+    is_svd_pending_ = false;
     apply_ineq_slacks_ = true;
 
-    for (int rank_id=0; rank_id<num_max_ranks_; rank_id++)
+    for (int rank_id=0; rank_id<num_max_ranks_; rank_id++) {
       RtMatrixUtils::resize(prev_K_[rank_id], Max_Num_Vars, 0);
+      RtMatrixUtils::resize(prev_B_Nprev_[rank_id], 0, Max_Num_Vars);
+    }
 
     stopSVD2ProblemConverter();
     stop_svd2problem_converter_ = false;
+    problem2svd_converter_.reset();
+    svd2problem_converter_.reset();
     svd2problem_converter_thread_.reset(new boost::thread(boost::bind( &RtHQPSolver<
-      All_A_Rows, Max_Num_Vars, Max_B_Rows>::doSVDComputations, this )) );
+      All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::doSVDComputations, this )) );
   }
 
-  // computation of singular value decompositions
-  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows>
-  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows>::doSVDComputations()
+  // computation of the nullspace of the current task
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
+  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::computeNullspace()
   {
-    while (!stop_svd2problem_converter_) {
-      // wait until svd is required
-      mutex_.lock();
-      while (!stop_svd2problem_converter_ && is_svd_computed_) { problem2svd_converter_.wait(mutex_); }
-      if (stop_svd2problem_converter_) { mutex_.unlock(); break; }
-
-      if(B_Nprev_.rows() != 0) {
+    // the nullspace of a level is reused if its projected constraints did not change since the last solve
+    if (B_Nprev_.rows() != 0 && reuse_factorizations_ && cur_rank_ < num_max_ranks_ &&
+        prev_B_Nprev_[cur_rank_].rows() == B_Nprev_.rows() && prev_B_Nprev_[cur_rank_].cols() == B_Nprev_.cols() &&
+        prev_B_Nprev_[cur_rank_] == B_Nprev_) {
+      K_ = prev_K_[cur_rank_];
+      num_reused_factorizations_++;
+    } else if(B_Nprev_.rows() != 0) {
+      if (use_qr_nullspace_) {
+        B_Nprev_transp_ = B_Nprev_.transpose();
+        qr_B_Nprev_.compute(B_Nprev_transp_);
+        RtMatrixUtils::computeNullspaceMap(B_Nprev_, K_, qr_B_Nprev_, eq_condition_threash_);
+      } else {
         svd_B_Nprev_.compute(B_Nprev_, Eigen::ComputeFullV);
         RtMatrixUtils::computeNullspaceMap(B_Nprev_, K_, svd_B_Nprev_, eq_condition_threash_);
+      }
+      if (cur_rank_ < num_max_ranks_) {
         prev_K_[cur_rank_] = K_;
+        prev_B_Nprev_[cur_rank_] = B_Nprev_;
       }
-      cur_rank_++;
+    }
+    cur_rank_++;
+  }
 
-      // notify main thread that svd is available now
-      is_svd_computed_ = true;
-      svd2problem_converter_.broadcast();
-      mutex_.unlock();
+  // computation of singular value decompositions
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
+  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::doSVDComputations()
+  {
+    this->configureSVDThread();
+
+    // each request is answered by one notification, there is at most one request in flight
+    RtEvent::SequenceType num_handled = 0;
+    while (true) {
+      problem2svd_converter_.wait(num_handled);
+      if (stop_svd2problem_converter_) { break; }
+      num_handled++;
+
+      this->computeNullspace();
+      svd2problem_converter_.notify();
     }
   }
 
-  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows>
-  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows>::stopSVD2ProblemConverter()
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
+  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::configureSVDThread()
+  {
+    #ifdef __linux__
+      if (svd_thread_cpu_ >= 0) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(svd_thread_cpu_, &cpu_set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) != 0)
+          std::cout << "RtHQPSolver: svd thread could not be pinned to cpu " << svd_thread_cpu_ << std::endl;
+      }
+    #endif
+
+    if (svd_thread_priority_ > 0) {
+      struct sched_param param;
+      param.sched_priority = svd_thread_priority_;
+      if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+        std::cout << "RtHQPSolver: svd thread could not be given SCHED_FIFO priority " << svd_thread_priority_ << std::endl;
+    }
+  }
+
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
+  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::stopSVD2ProblemConverter()
   {
     if(svd2problem_converter_thread_ != NULL)
     {
-      mutex_.lock();
       stop_svd2problem_converter_ = true;
-      problem2svd_converter_.broadcast();
-      mutex_.unlock();
+      problem2svd_converter_.notify();
       svd2problem_converter_thread_->join();
+      svd2problem_converter_thread_.reset();
     }
   }
 
   // solver reset
-  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows>
-  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows>::reset(int num_vars)
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
+  void RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::reset(int num_vars)
   {
-    mutex_.lock();
+    // the svd worker is idle between tasks, its data can be modified
     cur_rank_ = 0;
-    is_svd_computed_ = true;
+    task_id_ = 0;
+    num_reused_factorizations_ = 0;
+    is_svd_pending_ = false;
     RtMatrixUtils::setIdentity(K_, num_vars);
     RtMatrixUtils::resize(B_Nprev_, 0, num_vars);
-    mutex_.unlock();
 
     RtVectorUtils::resize(ahat_, 0);
     RtVectorUtils::resize(zopt_, 0);
@@ -107,9 +167,9 @@ namespace rt_solver {
   }
 
   // main function to solve a hierarchy
-  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows>
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks>
   template<typename EqMatDer, typename EqVecDer, typename IneqMatDer, typename IneqVecDer>
-  bool RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows>::solveNextTask(
+  bool RtHQPSolver<All_A_Rows, Max_Num_Vars, Max_B_Rows, Max_Num_Ranks>::solveNextTask(
     const Eigen::MatrixBase<EqMatDer>& eq_mat, const Eigen::MatrixBase<EqVecDer>& eq_vec,
     const Eigen::MatrixBase<IneqMatDer>& ineq_mat, const Eigen::MatrixBase<IneqVecDer>& ineq_vec)
   {
@@ -120,13 +180,12 @@ namespace rt_solver {
       assert(Ahat_.rows() + ineq_mat.rows() <= All_A_Rows && "HierarchicalTask exceeds max number of inequality constraints!");
     #endif
 
+    // tasks are identified by their order within the hierarchy to warm start them
+    const int task = task_id_++;
     if (eq_mat.rows() == 0 && ineq_mat.rows() == 0) { return true; }
 
-    // wait until svd is computed
-    mutex_.lock();
-
-    // use svd
-    if (K_.cols() == 0 && ineq_mat.rows() == 0) { mutex_.unlock(); return true; }
+    // use svd, it has been computed at the end of the previous task
+    if (K_.cols() == 0 && ineq_mat.rows() == 0) { return true; }
 
     //compute nullspace mapping of previous B_Nprev_
     if(Nprev_.cols() == K_.rows()) { Nprev_ *= K_; }
@@ -183,10 +242,14 @@ namespace rt_solver {
                                     eq_vec + eq_mat * xopt_);
     }
 
-    // notify problem2svd_converter that it can proceed
-    is_svd_computed_ = false;
-    problem2svd_converter_.broadcast();
-    mutex_.unlock();
+    // small problems are decomposed inline, otherwise problem2svd_converter is notified that it can proceed
+    if (B_Nprev_.rows()*B_Nprev_.cols() <= svd_inline_size_ || svd2problem_converter_thread_ == NULL) {
+      this->computeNullspace();
+    } else {
+      is_svd_pending_ = true;
+      svd_done_sequence_ = svd2problem_converter_.sequence();
+      problem2svd_converter_.notify();
+    }
 
 
     if (dim_w != 0 && apply_ineq_slacks_) { qp_solver_interface_.objectiveQuadPart().block(dim_z, dim_z, dim_w, dim_w).setIdentity(); }
@@ -211,10 +274,23 @@ namespace rt_solver {
     // solve
     if(apply_ineq_slacks_)
     {
+      // seed the solver with the active set this task had at the previous solve
+      bool is_warm_task = qp_solver_interface_.warmStart() && task < num_max_ranks_;
+      if (is_warm_task) { qp_solver_interface_.setActiveSet(task_active_set_[task], task_dim_qp_[task], task_num_ineq_[task]); }
+
+      // each task keeps its own hessian factor, the hessians of the tasks differ from each other
+      qp_solver_.useFactorCache(task < num_max_ranks_ ? &task_factor_cache_[task] : NULL);
+
       boost::posix_time::ptime wait_start(boost::posix_time::microsec_clock::local_time());
       try { qp_solver_interface_.optimize(); }
       catch (...) { std::cout << "Qp solver failed" << std::endl; }
 
+      if (is_warm_task) {
+        task_active_set_[task] = qp_solver_interface_.activeSet();
+        task_dim_qp_[task] = qp_solver_interface_.activeSetDimQp();
+        task_num_ineq_[task] = qp_solver_interface_.activeSetNumIneq();
+      }
+
       boost::posix_time::ptime wait_end(boost::posix_time::microsec_clock::local_time());
       boost::posix_time::time_duration dur = wait_end - wait_start;
       qpsolve_duration_ = dur.total_microseconds()/1000000.0;
@@ -226,9 +302,10 @@ namespace rt_solver {
 
     // synchronize with svd computation
     boost::posix_time::ptime wait_start(boost::posix_time::microsec_clock::local_time());
-    mutex_.lock();
-    while (!is_svd_computed_) { svd2problem_converter_.wait(mutex_); }
-    mutex_.unlock();
+    if (is_svd_pending_) {
+      svd2problem_converter_.wait(svd_done_sequence_);
+      is_svd_pending_ = false;
+    }
 
     boost::posix_time::ptime wait_end(boost::posix_time::microsec_clock::local_time());
     boost::posix_time::time_duration dur = wait_end - wait_start;
@@ -16,11 +16,12 @@
 
 namespace rt_solver {
 
-  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows>
+  // Max_Num_Ranks is the maximum depth of the hierarchy for which per-level data is kept
+  template<int All_A_Rows, int Max_Num_Vars, int Max_B_Rows, int Max_Num_Ranks = 7>
   class RtHQPSolver
   {
     private:
-      static const int num_max_ranks_=7;
+      static const int num_max_ranks_=Max_Num_Ranks;
       typedef RtQPSolver<Max_Num_Vars+All_A_Rows, 0, All_A_Rows> QpSolver;
       typedef RtQPSolverInterface<Max_Num_Vars + All_A_Rows, 0, All_A_Rows> QpSolverInterface;
 
@@ -41,8 +42,12 @@ namespace rt_solver {
       const double& qpWaitDuration() const { return wait_duration_; }
       const bool& applyIneqSlacks() const { return apply_ineq_slacks_; }
       const double& qpSolveDuration() const { return qpsolve_duration_; }
+      int qpNumAddSteps() const { return qp_solver_interface_.numAddSteps(); }
+      int qpNumDropSteps() const { return qp_solver_interface_.numDropSteps(); }
+      int qpNumFactorizations() const { return qp_solver_.numFactorizations(); }
 
       int nullspaceDimension() const { return K_.cols(); }
+      int numReusedFactorizations() const { return num_reused_factorizations_; }
       typename RtVector<Max_Num_Vars>::d& solution() { return xopt_; }
       const typename RtVector<Max_Num_Vars>::d& solution() const { return xopt_; }
 
@@ -52,16 +57,20 @@ namespace rt_solver {
       const typename RtMatrix<Max_Num_Vars, Max_Num_Vars>::d contrainedEqualityMat() const { return Nprev_; };
 
       // helper functions to handle svd operations
+      void computeNullspace();
       void doSVDComputations();
+      void configureSVDThread();
       void stopSVD2ProblemConverter();
 
 
     private:
       // helper integer variables
-      int cur_rank_;
+      int cur_rank_, task_id_, num_reused_factorizations_;
+      int task_dim_qp_[num_max_ranks_], task_num_ineq_[num_max_ranks_];
 
       // helper boolean variables
-      bool apply_ineq_slacks_, is_svd_computed_, stop_svd2problem_converter_;
+      bool apply_ineq_slacks_, is_svd_pending_, use_qr_nullspace_, reuse_factorizations_;
+      std::atomic<bool> stop_svd2problem_converter_;
 
       // helper double variables
       double wait_duration_, qpsolve_duration_, eq_condition_threash_,
@@ -81,11 +90,18 @@ namespace rt_solver {
       typename RtMatrix<Max_B_Rows, Max_Num_Vars>::d B_Nprev_;
       typename RtMatrix<Max_Num_Vars, Max_Num_Vars>::d Nprev_;
       typename RtMatrix<Max_Num_Vars, Max_Num_Vars>::d prev_K_[num_max_ranks_];
+      typename RtMatrix<Max_B_Rows, Max_Num_Vars>::d prev_B_Nprev_[num_max_ranks_];
+      typename RtVector<All_A_Rows>::i task_active_set_[num_max_ranks_];
+      typename QpSolver::FactorCache task_factor_cache_[num_max_ranks_];
       Eigen::JacobiSVD<typename RtMatrix<Max_B_Rows, Max_Num_Vars>::d> svd_B_Nprev_;
-
-      // rt communication and coordination
-      RtMutex mutex_;
-      RtCond svd2problem_converter_, problem2svd_converter_;
+      typename RtMatrix<Max_Num_Vars, Max_B_Rows>::d B_Nprev_transp_;
+      Eigen::ColPivHouseholderQR<typename RtMatrix<Max_Num_Vars, Max_B_Rows>::d> qr_B_Nprev_;
+
+      // rt communication and coordination: the svd of small problems is computed inline, otherwise
+      // it is handed off to a worker thread, optionally pinned to a cpu with real-time priority
+      int svd_inline_size_, svd_thread_cpu_, svd_thread_priority_;
+      RtEvent::SequenceType svd_done_sequence_;
+      RtEvent problem2svd_converter_, svd2problem_converter_;
       boost::shared_ptr<boost::thread> svd2problem_converter_thread_;
 
   };
@@ -253,6 +253,11 @@ namespace rt_solver {
         const Eigen::Matrix<double, _mat_rows, _mat_cols, _mat_align, max_mat_rows, max_mat_cols>& mat, Eigen::MatrixBase<nullDer>& null_map,
         const Eigen::JacobiSVD<typename RtMatrix<max_mat_rows, max_mat_cols>::d >& mat_svd, const double mat_cond_threas = mat_condition_thresh_);
 
+      // nullspace map from a column pivoting qr decomposition of the transpose of the matrix
+      template<typename matDer, typename nullDer, typename qrMatType>
+      static int computeNullspaceMap(const Eigen::MatrixBase<matDer>& mat, Eigen::MatrixBase<nullDer>& null_map,
+        const Eigen::ColPivHouseholderQR<qrMatType>& mat_transp_qr, const double mat_cond_threas = mat_condition_thresh_);
+
       template<typename Mat>
       static inline double conditionNumber(const Mat& mat)
       {
@@ -312,6 +317,36 @@ namespace rt_solver {
     return dim_range;
   }
 
+  template<typename matDer, typename nullDer, typename qrMatType>
+  int RtMatrixUtils::computeNullspaceMap(const Eigen::MatrixBase<matDer>& mat, Eigen::MatrixBase<nullDer>& null_map,
+    const Eigen::ColPivHouseholderQR<qrMatType>& mat_transp_qr, const double mat_cond_threas)
+  {
+    // mat' P = Q R, the diagonal of R is non-increasing in magnitude and estimates the singular values
+    int dim_range = 0;
+    const int dim_diag = std::min(mat.rows(), mat.cols());
+    const double first_diag = dim_diag > 0 ? std::abs(mat_transp_qr.matrixQR()(0,0)) : 0.0;
+    for (dim_range=0; dim_range<dim_diag; ++dim_range) {
+      const double diag = std::abs(mat_transp_qr.matrixQR()(dim_range,dim_range));
+      if (diag <= 0.0 || first_diag / diag > mat_cond_threas)
+        break;
+    }
+
+    // the last columns of Q span the orthogonal complement of the range of mat'
+    const int dim_null = mat.cols() - dim_range;
+    RtMatrixUtils::setZero(null_map, mat.cols(), dim_null);  //asserts that null_map has enough space
+
+    if (null_map.cols() > 0) {
+      null_map.bottomRows(dim_null).setIdentity();
+      null_map.applyOnTheLeft(mat_transp_qr.householderQ());
+    }
+
+    #ifndef RTEIG_NO_ASSERTS
+      assert((mat * null_map).norm() < 0.0001 && "Nullspace map is not correctly computed");
+      assert((null_map.transpose() * null_map - Eigen::MatrixXd::Identity(dim_null, dim_null)).norm() < 0.0001 && "Nullspace map is not correctly computed");
+    #endif
+    return dim_range;
+  }
+
 
   class RtVectorUtils
   {
@@ -14,8 +14,8 @@
 
 namespace rt_solver {
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::RtModel(YAML::Node params)
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::RtModel(YAML::Node params)
     : hqp_solver_(params)
   {
     is_solution_valid_ = false;
@@ -27,19 +27,19 @@ namespace rt_solver {
     }
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::initialize()
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::initialize()
   {
-    qp_dur_.resize(5);
-    svd_wait_.resize(5);
+    qp_dur_.resize(Max_Num_Ranks);
+    svd_wait_.resize(Max_Num_Ranks);
     hqp_solver_.initialize();
     is_solution_valid_ = false;
     hierarchies_without_slacks_.clear();
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
   template <typename Mat>
-  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::reduceColumns(Eigen::EigenBase<Mat>& mat) const
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::reduceColumns(Eigen::EigenBase<Mat>& mat) const
   {
     #ifndef RTEIG_NO_ASSERTS
       assert(mat.cols() == full_to_opt_variable_index_.size());
@@ -77,9 +77,9 @@ namespace rt_solver {
     rt_solver::RtMatrixUtils::conservativeResize(mat.derived(), mat.rows(), first_empty_i);
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
   template<int Max_Rows, typename Mat_Type, typename Vec_Type>
-  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::appendRowsOfRank(
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::appendRowsOfRank(
     int rank_to_add, const typename rt_solver::RtVector<Max_Rows>::i& ranks,
     const Eigen::MatrixBase<Mat_Type>& subst_mat, const Eigen::MatrixBase<Vec_Type>& subst_vec, bool append_to_equalities, int starting_column)
   {
@@ -125,9 +125,9 @@ namespace rt_solver {
     }
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
   template <typename VecDer>
-  double RtModel<  Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::inequalitySlack(Eigen::MatrixBase<VecDer>& dist) {
+  double RtModel<  Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::inequalitySlack(Eigen::MatrixBase<VecDer>& dist) {
     #ifndef RTEIG_NO_ASSERTS
       assert(dist.cols() == 1 && "dist has to be a vector");
     #endif
@@ -135,8 +135,8 @@ namespace rt_solver {
     return dist.norm();
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  bool RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::solve()
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  bool RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::solve()
   {
     n_solved_ranks_ = 0.0;
     is_solution_valid_ = true;
@@ -211,23 +211,23 @@ namespace rt_solver {
     return is_solution_valid_;
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::clean()
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::clean()
   {
     leqcons_.clear();
     lineqcons_.clear();
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  solver::Var RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::getVar(const int var_id)
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  solver::Var RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::getVar(const int var_id)
   {
     assert(var_id < Num_OptVars && "VarId exceeds max number of optimization variables available");
     return vars_[var_id];
   }
 
   // Linear Constraint: left_hand_side [< = >] right_hand_side
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::addLinConstr(const solver::LinExpr& lhs, const std::string sense, const solver::LinExpr& rhs, const int rank)
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::addLinConstr(const solver::LinExpr& lhs, const std::string sense, const solver::LinExpr& rhs, const int rank)
   {
     if (sense == "=") { leqcons_.push_back(std::make_tuple(rank, lhs-rhs)); }
     else if (sense == "<") { lineqcons_.push_back(std::make_tuple(rank, lhs-rhs)); }
@@ -235,8 +235,38 @@ namespace rt_solver {
     else { throw std::runtime_error("Invalid sense on Linear Constraint"); }
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  bool RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::checkIfHigherRanksLeft(const int rank)
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  template<typename Mat_Type, typename Vec_Type>
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::addLinConstr(const Eigen::MatrixBase<Mat_Type>& lhs,
+    const char sense, const Eigen::MatrixBase<Vec_Type>& rhs, int starting_column)
+  {
+    // all rows belong to the rank being composed, ranks are kept on the stack
+    static const int Max_Rows = Mat_Type::MaxRowsAtCompileTime;
+    static_assert(Max_Rows != Eigen::Dynamic, "Allocation-free constraints require row blocks of fixed maximum size");
+    typename rt_solver::RtVector<Max_Rows>::i ranks;
+    rt_solver::RtVectorUtils::resize(ranks, lhs.rows());
+    ranks.setZero();
+    this->template addLinConstr<Max_Rows>(0, ranks, lhs, sense, rhs, starting_column);
+  }
+
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  template<int Max_Rows, typename Mat_Type, typename Vec_Type>
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::addLinConstr(int rank_to_add,
+    const typename rt_solver::RtVector<Max_Rows>::i& ranks, const Eigen::MatrixBase<Mat_Type>& lhs,
+    const char sense, const Eigen::MatrixBase<Vec_Type>& rhs, int starting_column)
+  {
+    #ifndef RTEIG_NO_ASSERTS
+      assert(lhs.rows() == rhs.rows() && lhs.rows() == ranks.size() && "Inconsistent number of constraint rows");
+    #endif
+    // rows are stored as mat*x + vec [= <] 0
+    if (sense == '=') { this->template appendRowsOfRank<Max_Rows>(rank_to_add, ranks, lhs, -rhs, true, starting_column); }
+    else if (sense == '<') { this->template appendRowsOfRank<Max_Rows>(rank_to_add, ranks, lhs, -rhs, false, starting_column); }
+    else if (sense == '>') { this->template appendRowsOfRank<Max_Rows>(rank_to_add, ranks, -lhs, rhs, false, starting_column); }
+    else { throw std::runtime_error("Invalid sense on Linear Constraint"); }
+  }
+
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  bool RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::checkIfHigherRanksLeft(const int rank)
   {
     for (size_t leq_id=0; leq_id<leqcons_.size(); leq_id++)
       if (std::get<0>(leqcons_[leq_id]) > rank) { return true; }
@@ -246,8 +276,8 @@ namespace rt_solver {
     return false;
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::addCostsToHierarchy(const int rank_to_add)
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::addCostsToHierarchy(const int rank_to_add)
   {
     /*! appending linear equalities */
     // count how many rows we add in this rank
@@ -302,8 +332,8 @@ namespace rt_solver {
     }
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::checkSlacknessOfHierarchy(const int rank)
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::checkSlacknessOfHierarchy(const int rank)
   {
     for (size_t id=0; id<hierarchies_without_slacks_.size(); id ++)
       if (hierarchies_without_slacks_[id] == rank)
@@ -311,8 +341,8 @@ namespace rt_solver {
     hqp_solver_.applyIneqSlacks() = true;
   }
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
-  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars>::print()
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
+  void RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars, Max_Num_Ranks>::print()
   {
     for (int leq_id=0; leq_id<leqcons_.size(); leq_id++) {
       std::cout << " rank " << std::get<0>(leqcons_[leq_id])
@@ -16,7 +16,8 @@
 
 namespace rt_solver {
 
-  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
+  // Max_Num_Ranks is the maximum depth of the hierarchy, it defaults to 7 (see forward declaration in Var.hpp)
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars, int Max_Num_Ranks>
   class RtModel
   {
     public:
@@ -58,6 +59,14 @@ namespace rt_solver {
       void addLinConstr(const solver::LinExpr& lhs, const std::string sense, const solver::LinExpr& rhs, const int rank);
       void print();
 
+      // allocation-free counterparts of addLinConstr for the real-time path, to be called from RtHQPCost::addCostToHierarchy.
+      // Rows of lhs*x [sense] rhs, with sense one of '=', '<', '>', are written into the matrices of the rank being composed.
+      template<typename Mat_Type, typename Vec_Type>
+      void addLinConstr(const Eigen::MatrixBase<Mat_Type>& lhs, const char sense, const Eigen::MatrixBase<Vec_Type>& rhs, int starting_column = 0);
+      template<int Max_Rows, typename Mat_Type, typename Vec_Type>
+      void addLinConstr(int rank_to_add, const typename rt_solver::RtVector<Max_Rows>::i& ranks, const Eigen::MatrixBase<Mat_Type>& lhs,
+        const char sense, const Eigen::MatrixBase<Vec_Type>& rhs, int starting_column = 0);
+
       std::vector<int>& hierarchiesWithoutSlacks() { return hierarchies_without_slacks_; }
       const std::vector<int>& hierarchiesWithoutSlacks() const { return hierarchies_without_slacks_; }
 
@@ -67,7 +76,7 @@ namespace rt_solver {
       int num_variables_optimized_;
       std::vector<double> qp_dur_, svd_wait_;
       Eigen::Matrix<int, Num_OptVars, 1> full_to_opt_variable_index_;
-      mutable rt_solver::RtHQPSolver<Max_Ineq_Rows, Num_OptVars, Max_Eq_Rows> hqp_solver_;
+      mutable rt_solver::RtHQPSolver<Max_Ineq_Rows, Num_OptVars, Max_Eq_Rows, Max_Num_Ranks> hqp_solver_;
 
     private:
       std::vector<solver::Var> vars_;
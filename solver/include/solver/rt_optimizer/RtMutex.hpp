@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <pthread.h>
 
 namespace rt_solver {
@@ -52,4 +53,66 @@ namespace rt_solver {
       inline int destroy() { return pthread_cond_destroy(&c_); }
   };
 
+
+  /**
+   * Event to hand off work between a single producer and a single consumer.
+   * The notifier publishes by incrementing an atomic sequence number and only
+   * takes the lock if the waiter is parked. The waiter spins on the sequence
+   * number for a number of iterations before parking on a condition variable.
+   */
+  struct RtEvent
+  {
+    public:
+      typedef unsigned long long SequenceType;
+
+      RtEvent() : spin_count_(10000), sequence_(0), is_parked_(false) {}
+      ~RtEvent() {}
+
+      inline void reset() { sequence_.store(0); }
+      inline SequenceType sequence() const { return sequence_.load(std::memory_order_acquire); }
+
+      inline void notify()
+      {
+        sequence_.fetch_add(1, std::memory_order_seq_cst);
+        if (is_parked_.load(std::memory_order_seq_cst)) {
+          mutex_.lock();
+          cond_.broadcast();
+          mutex_.unlock();
+        }
+      }
+
+      // waits until the sequence number differs from the given one
+      inline void wait(SequenceType seq)
+      {
+        for (int iter=0; iter<spin_count_; iter++) {
+          if (sequence_.load(std::memory_order_acquire) != seq) { return; }
+          cpuRelax();
+        }
+
+        mutex_.lock();
+        is_parked_.store(true, std::memory_order_seq_cst);
+        while (sequence_.load(std::memory_order_seq_cst) == seq) { cond_.wait(mutex_); }
+        is_parked_.store(false, std::memory_order_relaxed);
+        mutex_.unlock();
+      }
+
+      int spin_count_;
+
+    private:
+      static inline void cpuRelax()
+      {
+        #if defined(__x86_64__) || defined(__i386__)
+          __builtin_ia32_pause();
+        #elif defined(__aarch64__)
+          asm volatile("yield");
+        #endif
+      }
+
+    private:
+      RtMutex mutex_;
+      RtCond cond_;
+      std::atomic<SequenceType> sequence_;
+      std::atomic<bool> is_parked_;
+  };
+
 }
@@ -22,6 +22,10 @@ namespace rt_solver {
       {
         cleanup_ineqs_ = false;
         is_inverse_provided_ = false;
+        hessian_unchanged_ = false;
+        max_rank_updates_ = -1;
+        num_factorizations_ = 0;
+        factor_cache_ = NULL;
       }
       virtual ~RtQPSolver(){}
 
@@ -38,6 +42,41 @@ namespace rt_solver {
       }
       bool isOptimized() const { return solver_return_ != std::numeric_limits<double>::infinity(); }
 
+      // cached hessian and factor J of its inverse, Hess^-1 = J * J'
+      struct FactorCache
+      {
+        FactorCache() : is_cached(false), trace(0.0) {}
+
+        bool is_cached;
+        double trace;
+        typename RtMatrix<nVars,nVars>::d hessian, factor_inv;
+      };
+
+      /*
+       * The factor of the hessian is cached between solves. It is reused if the hessian did not change,
+       * and updated in O(n^2) per entry if at most maxRankUpdates diagonal entries changed (a negative
+       * value means a quarter of the problem dimension). If set, hessianUnchanged skips the comparison
+       * with the cached hessian, the caller guarantees that it did not change. A caller solving several
+       * problems in turn can provide one cache per problem with useFactorCache, NULL selects the own one.
+       */
+      void useFactorCache(FactorCache* cache) { factor_cache_ = cache; }
+      bool& hessianUnchanged() { return hessian_unchanged_; }
+      int& maxRankUpdates() { return max_rank_updates_; }
+      int numFactorizations() const { return num_factorizations_; }
+      const bool& hessianUnchanged() const { return hessian_unchanged_; }
+      const int& maxRankUpdates() const { return max_rank_updates_; }
+
+      // applies Hess += sigma * v * v' to the objective and the cached factor of the hessian, e.g. after a task weight changed
+      template <typename Derived>
+      inline void hessianRankUpdate(const Eigen::MatrixBase<Derived>& v, double sigma)
+      {
+        BaseClass::objectiveQuadPart().noalias() += sigma * v * v.transpose();
+        FactorCache& cache = factorCache();
+        if (!cache.is_cached || cache.hessian.rows() != v.size()) { return; }
+        cache.hessian.noalias() += sigma * v * v.transpose();
+        if (!factorRankUpdate(v, sigma)) { cache.is_cached = false; }
+      }
+
     private:
       // definition of base class
       typedef RtQPSolverInterface<nVars, nEqCon, nIneqCon> BaseClass;
@@ -63,6 +102,80 @@ namespace rt_solver {
       typename RtMatrix<nVars,nVars>::d Hessian_factor_inv_;
       Eigen::LLT<typename RtMatrix<nVars,nVars>::d,Eigen::Lower> chol_;
 
+      // cache of the hessian factor in use, either the own one or one provided by the caller
+      bool hessian_unchanged_;
+      int max_rank_updates_, num_factorizations_;
+      FactorCache own_factor_cache_, *factor_cache_;
+      typename RtVector<nVars>::d factor_tmp_;
+
+      inline FactorCache& factorCache() { return factor_cache_ ? *factor_cache_ : own_factor_cache_; }
+
+      /*
+       * Rank one update of the factor J of the inverse for Hess + sigma * v * v'. With w = J' * v,
+       * the updated factor is J * (I + alpha * w * w'), where alpha solves (I + alpha w w')^2 =
+       * (I + sigma w w')^-1. It does not need to be triangular, the solver only uses J * J' = Hess^-1.
+       */
+      template <typename Derived>
+      inline bool factorRankUpdate(const Eigen::MatrixBase<Derived>& v, double sigma)
+      {
+        FactorCache& cache = factorCache();
+        RtVectorUtils::resize(factor_tmp_, v.size());
+        factor_tmp_.noalias() = cache.factor_inv.transpose() * v;
+        double w_norm_sqr = factor_tmp_.squaredNorm();
+        double scale = 1.0 + sigma * w_norm_sqr;
+        if (scale <= std::numeric_limits<double>::epsilon()) { return false; }  // hessian not positive definite anymore
+        if (w_norm_sqr == 0.0) { return true; }
+
+        double alpha = (1.0 / std::sqrt(scale) - 1.0) / w_norm_sqr;
+        typename RtVector<nVars>::d Jw = cache.factor_inv * factor_tmp_;
+        cache.factor_inv.noalias() += alpha * Jw * factor_tmp_.transpose();
+        cache.trace = cache.factor_inv.trace();
+        return true;
+      }
+
+      // makes the cached factor correspond to the given hessian, refactorizing only if necessary
+      inline void updateHessianFactor(const typename RtMatrix<nVars,nVars>::d & Hess)
+      {
+        int n = Hess.rows();
+        FactorCache& cache = factorCache();
+        if (cache.is_cached && cache.hessian.rows() == n) {
+          if (hessian_unchanged_) { return; }
+
+          // only changes on the diagonal are handled as rank one updates
+          int num_changes = 0, max_changes = max_rank_updates_ < 0 ? n/4 : max_rank_updates_;
+          bool is_diagonal_change = true;
+          for (int col = 0; col < n && is_diagonal_change; col++)
+            for (int row = 0; row < n; row++)
+              if (Hess(row,col) != cache.hessian(row,col)) {
+                if (row != col || ++num_changes > max_changes) { is_diagonal_change = false; break; }
+              }
+
+          if (is_diagonal_change) {
+            bool is_updated = true;
+            for (int id = 0; id < n && is_updated; id++) {
+              double sigma = Hess(id,id) - cache.hessian(id,id);
+              if (sigma == 0.0) { continue; }
+              is_updated = factorRankUpdate(RtVector<nVars>::d::Unit(n, id), sigma);
+              cache.hessian(id,id) = Hess(id,id);
+            }
+            if (is_updated) { return; }
+          }
+        }
+
+        /* decompose the matrix Hess in the form LL^T and compute J = L^-T */
+        chol_.compute(Hess);
+        RtMatrixUtils::setIdentity(cache.factor_inv, n);
+        cache.factor_inv = chol_.matrixU().solve(cache.factor_inv);
+        cache.trace = cache.factor_inv.trace();
+        cache.hessian = Hess;
+        cache.is_cached = true;
+        num_factorizations_++;
+
+        #ifndef RTEIG_NO_ASSERTS
+          assert(cache.factor_inv.rows() == n && cache.factor_inv.cols() == n);
+        #endif
+      }
+
       // helper function to measure a distance
       template<typename Scalar>
       inline Scalar distance(Scalar a, Scalar b)
@@ -258,6 +371,12 @@ namespace rt_solver {
         // int q; // warning unusued
         int iq, iter = 0;
 
+        /* the previous active set is only used if it belongs to a problem of the same dimensions */
+        bool warm_start = BaseClass::warm_start_ && !is_inverse_provided_ && BaseClass::active_set_.size() > 0 &&
+                          BaseClass::active_set_dim_qp_ == n && BaseClass::active_set_num_ineq_ == m;
+        BaseClass::num_add_steps_ = 0;
+        BaseClass::num_drop_steps_ = 0;
+
           me = p; /* number of equality constraints */
           mi = m; /* number of inequality constraints */
           // q = 0;  /* size of the active set A (containing the indices of the active constraints) */
@@ -268,8 +387,10 @@ namespace rt_solver {
           /* compute the trace of the original matrix Hess */
           c1 = Hess.trace();
 
-          /* decompose the matrix Hess in the form LL^T */
-          if(!is_inverse_provided_) { chol_.compute(Hess); }
+          /* decompose the matrix Hess in the form LL^T, or reuse the cached decomposition */
+          if(!is_inverse_provided_) { updateHessianFactor(Hess); }
+
+          l0: /* restart point of a failed warm start */
 
           /* initialize the matrix R */
           RtVectorUtils::setZero(d, n);
@@ -277,21 +398,16 @@ namespace rt_solver {
           R_norm = 1.0; /* this variable will hold the norm of the matrix R */
 
           /* compute the inverse of the factorized matrix Hess^-1, this is the initial value for H */
-          // Hessian_factor_inv_ = L^-T
+          // Hessian_factor_inv_ = L^-T, the working copy is rotated while constraints are added
           if(!is_inverse_provided_) {
-            RtMatrixUtils::setIdentity(Hessian_factor_inv_, n);
-            Hessian_factor_inv_ = chol_.matrixU().solve(Hessian_factor_inv_);
-
-            #ifndef RTEIG_NO_ASSERTS
-              assert(Hessian_factor_inv_.rows() == n && Hessian_factor_inv_.cols() == n);
-            #endif
+            Hessian_factor_inv_ = factorCache().factor_inv;
           } else {
             #ifndef RTEIG_NO_ASSERTS
               //std::cout << "hess*inv norm: " << (Hess*Hessian_factor_inv_*Hessian_factor_inv_.transpose() - Eigen::MatrixXd::Identity(Hess.rows(), Hess.cols())) << std::endl;
               assert((Hess*Hessian_factor_inv_*Hessian_factor_inv_.transpose() - Eigen::MatrixXd::Identity(Hess.rows(), Hess.cols())).norm() < 0.0001 && "inverse is weird");
             #endif
           }
-          c2 = Hessian_factor_inv_.trace();
+          c2 = is_inverse_provided_ ? Hessian_factor_inv_.trace() : factorCache().trace;
 
           /* c1 * c2 is an estimate for cond(Hess) */
 
@@ -300,8 +416,7 @@ namespace rt_solver {
            * this is a feasible point in the dual space
            * x = Hess^-1 * g0
            */
-          if(is_inverse_provided_) { x = Hessian_factor_inv_*Hessian_factor_inv_.transpose()*g0; }
-          else                     { x = chol_.solve(g0); }
+          x = Hessian_factor_inv_*(Hessian_factor_inv_.transpose()*g0);
           x = -x;
 
           /* and compute the current solution value */
@@ -339,10 +454,45 @@ namespace rt_solver {
               #ifndef RTEIG_NO_ASSERTS
                 assert(false && "equality constraints are linearly dependent");
               #endif
+              BaseClass::clearActiveSet();
               return f_value;
             }
           }
 
+          /* Add inequality constraints of the previous active set to the working set A, as done for
+           * equalities. The resulting S-pair is a valid starting point if the multipliers of all added
+           * constraints are non-negative, otherwise the solver falls back to a cold start. */
+          if (warm_start)
+          {
+            for (k = 0; k < BaseClass::active_set_.size() && warm_start; k++)
+            {
+              ip = BaseClass::active_set_(k);
+              np = -CI.row(ip);
+              computeD(d, Hessian_factor_inv_, np);
+              updateZ(z, Hessian_factor_inv_, d, iq);
+              updateR(R, r, d, iq);
+
+              /* constraint linearly dependent on the working set */
+              if (iq >= n || std::abs(z.dot(z)) <= std::numeric_limits<double>::epsilon()) { warm_start = false; break; }
+
+              t2 = (CI.row(ip).dot(x) + ci0(ip)) / z.dot(np);
+              x += t2 * z;
+              u(iq) = t2;
+              u.head(iq) -= t2 * r.head(iq);
+              f_value += 0.5 * (t2 * t2) * z.dot(np);
+              A(iq) = ip;
+              if (!addConstraint(R, Hessian_factor_inv_, d, iq, R_norm)) { warm_start = false; }
+            }
+            for (i = me; i < iq && warm_start; i++)
+              if (u(i) < 0.0) { warm_start = false; }
+
+            if (!warm_start)
+            {
+              /* the working factor of the hessian has been rotated, it is copied again before starting over */
+              goto l0;
+            }
+          }
+
           /* set iai = K \ A */
           for (i = 0; i < mi; i++)
             iai(i) = i;
@@ -372,6 +522,7 @@ namespace rt_solver {
           {
             /* numerically there are not infeasibilities anymore */
             // q = iq;
+            this->setActiveSet(A.segment(me, iq-me), n, m);
             return f_value;
           }
 
@@ -392,6 +543,7 @@ namespace rt_solver {
           if (ss >= 0.0)
           {
             // q = iq;
+            this->setActiveSet(A.segment(me, iq-me), n, m);
             return f_value;
           }
 
@@ -449,6 +601,7 @@ namespace rt_solver {
             /* QPP is infeasible */
             // FIXME: unbounded to raise
             // q = iq;
+            BaseClass::clearActiveSet();
             return inf;
           }
           /* case (ii): step in dual space */
@@ -459,6 +612,7 @@ namespace rt_solver {
             u(iq) += t;
             iai(l) = l;
             deleteConstraint(R, Hessian_factor_inv_, A, u, p, iq, l);
+            BaseClass::num_drop_steps_++;
 
             goto l2a;
           }
@@ -493,7 +647,10 @@ namespace rt_solver {
               goto l2; /* go to step 2 */
             }
             else
+            {
               iai(ip) = -1;
+              BaseClass::num_add_steps_++;
+            }
             goto l1;
           }
 
@@ -501,6 +658,7 @@ namespace rt_solver {
           /* drop constraint l */
           iai(l) = l;
           deleteConstraint(R, Hessian_factor_inv_, A, u, p, iq, l);
+          BaseClass::num_drop_steps_++;
 
           s(ip) = -(CI.row(ip).dot(x) + ci0(ip));
 
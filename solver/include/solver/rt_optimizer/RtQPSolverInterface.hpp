@@ -27,6 +27,11 @@ namespace rt_solver {
       typename RtMatrix<max_num_eq, max_dim_qp>::d Eq_mat_;
       typename RtMatrix<max_num_ineq, max_dim_qp>::d Ineq_mat_;
 
+      // active set of inequalities at the last solution, used to seed the next solve
+      bool warm_start_;
+      typename RtVector<max_num_ineq>::i active_set_;
+      int active_set_dim_qp_, active_set_num_ineq_, num_add_steps_, num_drop_steps_;
+
     public:
       enum QPProperties {
         //ePP_ObjectivePD = 1 << 3,
@@ -63,8 +68,35 @@ namespace rt_solver {
       int numEqConstr() const { return Eq_mat_.rows(); }
       int numIneqConstr() const { return Ineq_mat_.rows(); }
 
+      // warm start from the active set of the previous solution, kept across resets
+      bool& warmStart() { return warm_start_; }
+      const bool& warmStart() const { return warm_start_; }
+      const typename RtVector<max_num_ineq>::i& activeSet() const { return active_set_; }
+      int activeSetDimQp() const { return active_set_dim_qp_; }
+      int activeSetNumIneq() const { return active_set_num_ineq_; }
+      int numAddSteps() const { return num_add_steps_; }
+      int numDropSteps() const { return num_drop_steps_; }
+
+      // replaces the active set, e.g. to switch between the problems of a hierarchy
+      template <typename Derived>
+      inline void setActiveSet(const Eigen::MatrixBase<Derived>& active_set, int dim_qp, int num_ineq)
+      {
+        active_set_ = active_set;
+        active_set_dim_qp_ = dim_qp;
+        active_set_num_ineq_ = num_ineq;
+      }
+      inline void clearActiveSet()
+      {
+        RtVectorUtils::resize(active_set_, 0);
+        active_set_dim_qp_ = active_set_num_ineq_ = 0;
+      }
+
       // constructor and destructor
-      RtQPSolverInterface() { this->reset(); }
+      RtQPSolverInterface() : warm_start_(false), num_add_steps_(0), num_drop_steps_(0)
+      {
+        this->reset();
+        this->clearActiveSet();
+      }
       virtual ~RtQPSolverInterface(){}
 
       // functions to be implemented to use the interface
@@ -25,12 +25,13 @@ namespace solver {
   NesterovToddScaling::NesterovToddScaling(int conesize)
   {
 	wbar_.resize(conesize);
-	SOC_id_.resize(3*conesize+1);
+	SOC_id_.resize(std::max(3*conesize+1, conesize*(conesize+1)/2));
   }
 
-  void Cone::initialize(int nvars, int nleq, int nlineq, const Eigen::VectorXi& nsoc)
+  void Cone::initialize(int nvars, int nleq, int nlineq, const Eigen::VectorXi& nsoc, int nbox)
   {
 	neq_ = nleq;
+	nbox_ = nbox;
 	nvars_ = nvars;
 	ssoc_ = nsoc.sum();
 	nsoc_ = nsoc.size();
@@ -220,7 +221,7 @@ namespace solver {
   }
 
   void Cone::unpermuteSolution(const Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic>& Perm,
-                               const Eigen::VectorXd& Px, OptimizationVector& sd) const
+                               const Eigen::Ref<const Eigen::VectorXd>& Px, OptimizationVector& sd) const
   {
 	double* dx = sd.x().data();
 	double* dy = sd.y().data();
@@ -239,7 +240,7 @@ namespace solver {
   }
 
   void Cone::unpermuteSolution(const Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic>& Perm,
-                               const Eigen::VectorXd& Px, OptimizationVector& sd, Eigen::VectorXd& permdZ) const
+                               const Eigen::Ref<const Eigen::VectorXd>& Px, OptimizationVector& sd, Eigen::VectorXd& permdZ) const
   {
 	double* dx = sd.x().data();
 	double* dy = sd.y().data();
@@ -433,6 +434,8 @@ namespace solver {
     u_prev_opt_.initialize(cone);
     this->Amatrix().resize(cone_->numLeq(), cone_->numVars());
     this->Gmatrix().resize(cone_->sizeLpc() + cone_->sizeSoc(), cone_->numVars());
+    box_index_.resize(cone_->sizeBox());
+    box_coeff_.resize(cone_->sizeBox());
   }
 
   void SolverStorage::addCoeff(const Eigen::Triplet<double>& coeff, bool flag_eq)
@@ -443,11 +446,47 @@ namespace solver {
 
   void SolverStorage::initializeMatrices()
   {
-	this->Amatrix().setFromTriplets(Acoeffs_.begin(), Acoeffs_.end());
-	if (!this->Amatrix().isCompressed()) { this->Amatrix().makeCompressed(); }
+    this->assembleMatrix(Acoeffs_, this->Amatrix());
+    this->assembleMatrix(Gcoeffs_, this->Gmatrix());
+  }
+
+  void SolverStorage::assembleMatrix(const std::vector<Eigen::Triplet<double>>& coeffs, Eigen::SparseMatrix<double>& mat)
+  {
+    // compressed column storage filled directly from the coefficients: a counting sort
+    // by row followed by a stable bucketing by column leaves every column sorted by row
+    int nrows = mat.rows(), ncols = mat.cols(), ncoeffs = coeffs.size();
+    row_count_.assign(nrows+1, 0);
+    col_count_.assign(ncols+1, 0);
+    row_order_.resize(ncoeffs);
+    for (int id=0; id<ncoeffs; id++) { row_count_[coeffs[id].row()+1]++; col_count_[coeffs[id].col()+1]++; }
+    for (int row=0; row<nrows; row++) { row_count_[row+1] += row_count_[row]; }
+    for (int col=0; col<ncols; col++) { col_count_[col+1] += col_count_[col]; }
+    for (int id=0; id<ncoeffs; id++) { row_order_[row_count_[coeffs[id].row()]++] = id; }
+
+    mat.makeCompressed();
+    mat.resizeNonZeros(ncoeffs);
+    int* Mp = mat.outerIndexPtr();
+    int* Mi = mat.innerIndexPtr();
+    double* Mx = mat.valuePtr();
+    for (int col=0; col<=ncols; col++) { Mp[col] = col_count_[col]; }
+    for (int id=0; id<ncoeffs; id++) {
+      const Eigen::Triplet<double>& coeff = coeffs[row_order_[id]];
+      int k = col_count_[coeff.col()]++;
+      Mi[k] = coeff.row();  Mx[k] = coeff.value();
+    }
 
-    this->Gmatrix().setFromTriplets(Gcoeffs_.begin(), Gcoeffs_.end());
-    if (!this->Gmatrix().isCompressed()) { this->Gmatrix().makeCompressed(); }
+    // repeated coefficients are adjacent within their column, they are summed up in place
+    int nnz = 0;
+    for (int col=0; col<ncols; col++) {
+      int start = nnz;
+      for (int k=Mp[col]; k<Mp[col+1]; k++) {
+        if (nnz>start && Mi[nnz-1]==Mi[k]) { Mx[nnz-1] += Mx[k]; }
+        else { Mi[nnz] = Mi[k];  Mx[nnz++] = Mx[k]; }
+      }
+      Mp[col] = start;
+    }
+    Mp[ncols] = nnz;
+    mat.resizeNonZeros(nnz);
   }
 
 }
@@ -6,7 +6,9 @@
  * @date 2019-10-06
  */
 
+#include <cmath>
 #include <iomanip>
+#include <algorithm>
 #include <iostream>
 #include <solver/interface/ConicProblem.hpp>
 
@@ -22,12 +24,17 @@ namespace solver {
 	vars_.clear();
 	leqcons_.clear();
 	soccons_.clear();
+	boundcons_.clear();
 	bin_vars_.clear();
 	lineqcons_.clear();
 	qineqcons_.clear();
 	objective_.clear();
 	numTrustRegions_ = 0;
 	numSoftConstraints_ = 0;
+	scp_cols_.clear();
+	scp_center_.clear();
+	scp_qvalues_.clear();
+	scp_radius_ = SolverSetting::inf;
   }
 
   Var ConicProblem::addVar(const VarType& type, double lb, double ub, double guess)
@@ -47,12 +54,17 @@ namespace solver {
   }
 
   // Linear Constraint: left_hand_side [< = >] right_hand_side
+  // Inequalities on a single variable are kept apart as box constraints
   void ConicProblem::addLinConstr(const LinExpr& lhs, const std::string sense, const LinExpr& rhs)
   {
-    if (sense == "=") { leqcons_.push_back(lhs-rhs); }
-    else if (sense == "<") { lineqcons_.push_back(lhs-rhs); }
-    else if (sense == ">") { lineqcons_.push_back(rhs-lhs); }
+    LinExpr expr;
+    if (sense == "=") { leqcons_.push_back(lhs-rhs); return; }
+    else if (sense == "<") { expr = lhs-rhs; }
+    else if (sense == ">") { expr = rhs-lhs; }
     else { throw std::runtime_error("Invalid sense on Linear Constraint"); }
+
+    if (expr.size() == 1 && expr.getCoeff(0) != 0.0) { boundcons_.push_back(expr); }
+    else { lineqcons_.push_back(expr); }
   }
 
   // Disciplined Convex Quadratic Constraint: Sum coeffs[i]* (DCP.qexpr[i])^2 + (DCP.lexpr - lexpr) [< =] 0.0
@@ -114,13 +126,15 @@ namespace solver {
 
 	int nvars  = vars_.size();
 	int nleq   = leqcons_.size();
-	int nlineq = 2.0*bin_vars_.size() + lineqcons_.size() + qineqcons_.size() +
+	int nradius = (!warm_start && scp_radius_<SolverSetting::inf) ? 2.0*scp_cols_.size() : 0;
+	int nbox   = 2.0*bin_vars_.size() + boundcons_.size() + nradius;
+	int nlineq = nbox + lineqcons_.size() + qineqcons_.size() +
 			     soccons_.size() + (warm_start == true ? 0 : numTrustRegions_);
 	Eigen::VectorXi q(mextra); q.setConstant(3);
     for (int id=0; id<(int)soccons_.size(); id++)
       q.tail(soccons_.size())[id] = soccons_[id].coeffs().size()+1;
 
-	this->getCone().initialize(nvars, nleq, nlineq, q);
+	this->getCone().initialize(nvars, nleq, nlineq, q, nbox);
 	this->getStorage().initialize(cone_, stgs_);
 	this->getStorage().cleanCoeffs();
 
@@ -134,15 +148,33 @@ namespace solver {
 	  }
     }
 
-    // Linear inequality constraints due to integer variables
+    // Box constraints due to integer variables
     for (int var_id=0; var_id<(int)bin_vars_.size(); var_id++) {
-      this->getStorage().addCoeff(Eigen::Triplet<double>(row_start+row_offset+2*var_id  , bin_vars_[var_id]->get(SolverIntParam_ColNum), -1.0));
-      this->getStorage().addCoeff(Eigen::Triplet<double>(row_start+row_offset+2*var_id+1, bin_vars_[var_id]->get(SolverIntParam_ColNum),  1.0));
+      this->getStorage().addBoxCoeff(row_start+row_offset+2*var_id  , bin_vars_[var_id]->get(SolverIntParam_ColNum), -1.0);
+      this->getStorage().addBoxCoeff(row_start+row_offset+2*var_id+1, bin_vars_[var_id]->get(SolverIntParam_ColNum),  1.0);
       this->getStorage().h()[row_start+2*var_id  ] = this->binaryLowerBounds()[var_id];
       this->getStorage().h()[row_start+2*var_id+1] = this->binaryUpperBounds()[var_id];
     }
     row_start += 2.0*bin_vars_.size();
 
+    // Box constraints on single variables
+    for (int row_id=0; row_id<(int)boundcons_.size(); row_id++) {
+      this->getStorage().addBoxCoeff(row_start+row_offset+row_id,
+                                     boundcons_[row_id].getVar(0).get(SolverIntParam_ColNum),
+                                     boundcons_[row_id].getCoeff(0));
+      this->getStorage().h()[row_start+row_id] = -boundcons_[row_id].getConstant();
+    }
+    row_start += boundcons_.size();
+
+    // Box constraints of the trust region around the linearization point
+    for (int col_id=0; col_id<nradius/2; col_id++) {
+      this->getStorage().addBoxCoeff(row_start+row_offset+2*col_id  , scp_cols_[col_id], -1.0);
+      this->getStorage().addBoxCoeff(row_start+row_offset+2*col_id+1, scp_cols_[col_id],  1.0);
+      this->getStorage().h()[row_start+2*col_id  ] = scp_radius_ - scp_center_[scp_cols_[col_id]];
+      this->getStorage().h()[row_start+2*col_id+1] = scp_radius_ + scp_center_[scp_cols_[col_id]];
+    }
+    row_start += nradius;
+
     // Linear inequality constraints
     for (int row_id=0; row_id<(int)lineqcons_.size(); row_id++) {
 	  for (int var_id=0; var_id<(int)lineqcons_[row_id].size(); var_id++) {
@@ -335,6 +367,7 @@ namespace solver {
   ExitCode ConicProblem::optimize()
   {
     exit_code_ = ExitCode::Indeterminate;
+    scp_radius_ = SolverSetting::inf;
 
     // warm start solution
     if (this->getSetting().get(SolverIntParam_WarmStartIters)>0 && (numTrustRegions_>0 || numSoftConstraints_>0)) {
@@ -350,16 +383,123 @@ namespace solver {
       exit_code_ = this->solveProblem();
     }
 
-    // perform refinements if required
-    if (this->getSetting().get(SolverIntParam_NumberRefinementsTrustRegion) > 0 && (numTrustRegions_>0 || numSoftConstraints_>0)) {
+    // perform refinements if required: steps are accepted by the ratio of actual to predicted
+    // reduction of the merit function f(x) + weight*violation(x), the trust region around the
+    // linearization point grows or shrinks with this ratio, and refinements stop as soon as the
+    // linearization point and the violation of the nonconvex constraints have converged
+    int num_refinements = 0;
+    double violation = 0.0, predicted_violation = 0.0;
+    if (numTrustRegions_>0 || numSoftConstraints_>0) {
+      double weight = this->getSetting().get(SolverDoubleParam_SoftConstraintWeightFull);
+      scp_radius_ = this->getSetting().get(SolverDoubleParam_ScpInitialRadius);
+      this->linearizeNonconvexConstraints();
+      scp_cone_ = cone_;
+      scp_info_ = ip_solver_.getInfo();
+      scp_info_.get(SolverIntParam_NumIter) = ip_solver_.getInfo().get(SolverIntParam_NumIter);
+      scp_info_.mode() = ip_solver_.getInfo().mode();
+      scp_opt_ = ip_solver_.optimalVector();
+      this->nonconvexViolation(violation, predicted_violation);
+      double merit = this->objectiveValue() + weight*violation;
+
       for (int ref=1; ref<=this->getSetting().get(SolverIntParam_NumberRefinementsTrustRegion); ref++) {
-      	this->getSetting().set(SolverIntParam_MaxIters, this->getSetting().get(SolverIntParam_SolverMaxIters));
+        this->getSetting().set(SolverIntParam_MaxIters, this->getSetting().get(SolverIntParam_SolverMaxIters));
         this->buildProblem(ref+1);
-        exit_code_ = this->solveProblem();
+        ExitCode exit_code = this->solveProblem();
+        num_refinements = ref;
+
+        double step = this->stepNorm();
+        this->nonconvexViolation(violation, predicted_violation);
+        double actual_reduction = merit - this->objectiveValue() - weight*violation;
+        double predicted_reduction = merit - this->objectiveValue() - weight*predicted_violation;
+        double ratio = predicted_reduction>0.0 ? actual_reduction/predicted_reduction : (actual_reduction>=predicted_reduction ? 1.0 : -1.0);
+
+        if ((exit_code==ExitCode::Optimal || exit_code==ExitCode::OptimalInacc) && ratio>0.0) {
+          exit_code_ = exit_code;
+          merit -= actual_reduction;
+          if (ratio<0.25) { scp_radius_ = 0.5*std::min(scp_radius_, step); }
+          else if (ratio>0.75) { scp_radius_ = std::max(scp_radius_, 2.0*step); }
+          this->linearizeNonconvexConstraints();
+          scp_cone_ = cone_;
+          scp_info_ = ip_solver_.getInfo();
+          scp_info_.get(SolverIntParam_NumIter) = ip_solver_.getInfo().get(SolverIntParam_NumIter);
+          scp_info_.mode() = ip_solver_.getInfo().mode();
+          scp_opt_ = ip_solver_.optimalVector();
+          if (step<=this->getSetting().get(SolverDoubleParam_ScpStepTolerance) &&
+              violation<=this->getSetting().get(SolverDoubleParam_ScpViolationTolerance)) { break; }
+        } else {
+          // rejected step: back to the linearization point and the solve that found it, with a smaller trust region
+          for (int var_id=0; var_id<(int)vars_.size(); var_id++)
+            vars_[var_id]->set(SolverDoubleParam_X, scp_center_[var_id]);
+          cone_ = scp_cone_;
+          ip_solver_.getInfo() = scp_info_;
+          ip_solver_.getInfo().get(SolverIntParam_NumIter) = scp_info_.get(SolverIntParam_NumIter);
+          ip_solver_.getInfo().mode() = scp_info_.mode();
+          ip_solver_.optimalVector() = scp_opt_;
+          this->nonconvexViolation(violation, predicted_violation);
+          scp_radius_ = 0.5*std::min(scp_radius_, step);
+          if (scp_radius_<=this->getSetting().get(SolverDoubleParam_ScpStepTolerance)) { break; }
+        }
       }
     }
+    ip_solver_.getInfo().get(SolverIntParam_NumScpRefinements) = num_refinements;
+    ip_solver_.getInfo().get(SolverDoubleParam_NonconvexViolation) = violation;
 
     return exit_code_;
   }
 
+  // Objective of the original problem at the current values of the variables
+  double ConicProblem::objectiveValue() const
+  {
+    return objective_.getValue() + objective_.lexpr().getValue();
+  }
+
+  // Largest change of the variables in nonconvex terms with respect to the linearization point
+  double ConicProblem::stepNorm() const
+  {
+    double step = 0.0;
+    for (int col_id=0; col_id<(int)scp_cols_.size(); col_id++)
+      step = std::max(step, std::abs(vars_[scp_cols_[col_id]]->get(SolverDoubleParam_X) - scp_center_[scp_cols_[col_id]]));
+    return step;
+  }
+
+  // Current values of the variables become the linearization point of the nonconvex constraints
+  void ConicProblem::linearizeNonconvexConstraints()
+  {
+    scp_cols_.clear();
+    scp_qvalues_.clear();
+    scp_center_.resize(vars_.size());
+    for (int var_id=0; var_id<(int)vars_.size(); var_id++)
+      scp_center_[var_id] = vars_[var_id]->get(SolverDoubleParam_X);
+
+    for (int row_id=0; row_id<(int)qineqcons_.size(); row_id++) {
+      if (qineqcons_[row_id].trustRegion() || qineqcons_[row_id].softConstraint()) {
+        for (int qvar_id=0; qvar_id<(int)qineqcons_[row_id].qexpr().size(); qvar_id++) {
+          scp_qvalues_.push_back(qineqcons_[row_id].qexpr()[qvar_id].getValue());
+          for (int lvar_id=0; lvar_id<(int)qineqcons_[row_id].qexpr()[qvar_id].size(); lvar_id++)
+            scp_cols_.push_back(qineqcons_[row_id].getVar(qvar_id, lvar_id).get(SolverIntParam_ColNum));
+        }
+      }
+    }
+    std::sort(scp_cols_.begin(), scp_cols_.end());
+    scp_cols_.erase(std::unique(scp_cols_.begin(), scp_cols_.end()), scp_cols_.end());
+  }
+
+  // Sum of violations max(0, -g(x)) of the nonconvex constraints g(x) = Sum coeffs[i]*(qexpr[i])^2 + lexpr >= 0,
+  // evaluated at the current values of the variables and on the linearization used by the last refinement
+  void ConicProblem::nonconvexViolation(double& violation, double& predicted_violation) const
+  {
+    int qvalue_id = 0;
+    violation = predicted_violation = 0.0;
+    for (int row_id=0; row_id<(int)qineqcons_.size(); row_id++) {
+      if (qineqcons_[row_id].trustRegion() || qineqcons_[row_id].softConstraint()) {
+        double value = qineqcons_[row_id].lexpr().getValue() + qineqcons_[row_id].getValue();
+        double predicted_value = qineqcons_[row_id].lexpr().getValue();
+        for (int qvar_id=0; qvar_id<(int)qineqcons_[row_id].qexpr().size(); qvar_id++, qvalue_id++)
+          predicted_value += qineqcons_[row_id].coeffs()[qvar_id]*scp_qvalues_[qvalue_id]*(2.0*qineqcons_[row_id].qexpr()[qvar_id].getValue() - scp_qvalues_[qvalue_id]);
+        violation += std::max(0.0, -value);
+        predicted_violation += std::max(0.0, -predicted_value);
+      }
+    }
+  }
+
 }
@@ -47,6 +47,10 @@ namespace solver {
 	  num_iter_ref_lin_solve_ = solver_vars["num_iter_ref_lin_solve"].as<int>();
 	  static_regularization_ = solver_vars["static_regularization"].as<double>();
 	  dynamic_regularization_ = solver_vars["dynamic_regularization"].as<double>();
+	  kkt_ordering_ = solver_vars["kkt_ordering"] ? solver_vars["kkt_ordering"].as<int>() : static_cast<int>(KktOrdering::Amd);
+	  dense_kkt_threshold_ = solver_vars["dense_kkt_threshold"] ? solver_vars["dense_kkt_threshold"].as<int>() : 16;
+	  dense_soc_threshold_ = solver_vars["dense_soc_threshold"] ? solver_vars["dense_soc_threshold"].as<int>() : 0;
+	  ordering_cache_dir_ = solver_vars["ordering_cache_dir"] ? solver_vars["ordering_cache_dir"].as<std::string>() : "";
 
       // Algorithm parameters
 	  safeguard_ = solver_vars["safeguard"].as<double>();
@@ -55,6 +59,9 @@ namespace solver {
 	  min_centering_step_ = solver_vars["min_centering_step"].as<double>();
 	  max_centering_step_ = solver_vars["max_centering_step"].as<double>();
 	  step_length_scaling_ = solver_vars["step_length_scaling"].as<double>();
+	  max_centrality_correctors_ = solver_vars["max_centrality_correctors"] ? solver_vars["max_centrality_correctors"].as<int>() : 0;
+	  corrector_step_increase_ = solver_vars["corrector_step_increase"] ? solver_vars["corrector_step_increase"].as<double>() : 0.5;
+	  corrector_acceptance_ = solver_vars["corrector_acceptance"] ? solver_vars["corrector_acceptance"].as<double>() : 0.1;
 
 	  // Model parameters
 	  verbose_ = solver_vars["verbose"].as<bool>();
@@ -67,6 +74,16 @@ namespace solver {
 	  trust_region_threshold_ = solver_vars["trust_region_threshold"].as<double>();
 	  soft_constraint_weight_full_ = solver_vars["soft_constraint_weight_full"].as<double>();
 	  soft_constraint_weight_reduced_ = solver_vars["soft_constraint_weight_reduced"].as<double>();
+	  scp_initial_radius_ = solver_vars["scp_initial_radius"] ? solver_vars["scp_initial_radius"].as<double>() : SolverSetting::inf;
+	  scp_step_tolerance_ = solver_vars["scp_step_tolerance"] ? solver_vars["scp_step_tolerance"].as<double>() : 1e-4;
+	  scp_violation_tolerance_ = solver_vars["scp_violation_tolerance"] ? solver_vars["scp_violation_tolerance"].as<double>() : 1e-6;
+
+	  // Augmented Lagrangian parameters
+	  al_max_iters_ = solver_vars["al_max_iters"] ? solver_vars["al_max_iters"].as<int>() : 20;
+	  al_feasibility_tolerance_ = solver_vars["al_feasibility_tolerance"] ? solver_vars["al_feasibility_tolerance"].as<double>() : 1e-6;
+	  al_optimality_tolerance_ = solver_vars["al_optimality_tolerance"] ? solver_vars["al_optimality_tolerance"].as<double>() : 1e-5;
+	  al_initial_penalty_ = solver_vars["al_initial_penalty"] ? solver_vars["al_initial_penalty"].as<double>() : 10.0;
+	  al_penalty_growth_ = solver_vars["al_penalty_growth"] ? solver_vars["al_penalty_growth"].as<double>() : 10.0;
     }
     catch (YAML::ParserException &e)
     {
@@ -118,12 +135,21 @@ namespace solver {
 
       // Linear System parameters
       case SolverIntParam_NumIterRefinementsLinSolve : { return num_iter_ref_lin_solve_; }
+      case SolverIntParam_KktOrdering : { return kkt_ordering_; }
+      case SolverIntParam_DenseKktThreshold : { return dense_kkt_threshold_; }
+      case SolverIntParam_DenseSocThreshold : { return dense_soc_threshold_; }
+
+      // Algorithm parameters
+      case SolverIntParam_MaxCentralityCorrectors : { return max_centrality_correctors_; }
 
       // Model parameters
       case SolverIntParam_MaxIters: { return max_iters_; }
       case SolverIntParam_SolverMaxIters : { return ipsolver_max_iters_; }
       case SolverIntParam_WarmStartIters : { return ipsolver_warm_iters_; }
       case SolverIntParam_NumberRefinementsTrustRegion : { return num_itrefs_trustregion_; }
+
+      // Augmented Lagrangian parameters
+      case SolverIntParam_AugLagMaxIters : { return al_max_iters_; }
       default: { throw std::runtime_error("SolverSetting::get SolverIntParam invalid"); break; }
     }
   }
@@ -140,12 +166,21 @@ namespace solver {
 
       // Linear System parameters
       case SolverIntParam_NumIterRefinementsLinSolve : { num_iter_ref_lin_solve_ = value; break; }
+      case SolverIntParam_KktOrdering : { kkt_ordering_ = value; break; }
+      case SolverIntParam_DenseKktThreshold : { dense_kkt_threshold_ = value; break; }
+      case SolverIntParam_DenseSocThreshold : { dense_soc_threshold_ = value; break; }
+
+      // Algorithm parameters
+      case SolverIntParam_MaxCentralityCorrectors : { max_centrality_correctors_ = value; break; }
 
       // Model parameters
       case SolverIntParam_MaxIters : { max_iters_ = value; break; }
       case SolverIntParam_SolverMaxIters : { ipsolver_max_iters_ = value; break; }
       case SolverIntParam_WarmStartIters : { ipsolver_warm_iters_ = value; break; }
       case SolverIntParam_NumberRefinementsTrustRegion : { num_itrefs_trustregion_ = value; break; }
+
+      // Augmented Lagrangian parameters
+      case SolverIntParam_AugLagMaxIters : { al_max_iters_ = value; break; }
       default: { throw std::runtime_error("SolverSetting::set SolverIntParam invalid"); break; }
     }
   }
@@ -182,11 +217,22 @@ namespace solver {
       case SolverDoubleParam_StepLengthScaling : { return step_length_scaling_; }
       case SolverDoubleParam_MinimumCenteringStep : { return min_centering_step_; }
       case SolverDoubleParam_MaximumCenteringStep : { return max_centering_step_; }
+      case SolverDoubleParam_CorrectorStepIncrease : { return corrector_step_increase_; }
+      case SolverDoubleParam_CorrectorAcceptance : { return corrector_acceptance_; }
 
       // Model parameters
       case SolverDoubleParam_TrustRegionThreshold : { return trust_region_threshold_; }
       case SolverDoubleParam_SoftConstraintWeightFull : { return soft_constraint_weight_full_; }
       case SolverDoubleParam_SoftConstraintWeightReduced : { return soft_constraint_weight_reduced_; }
+      case SolverDoubleParam_ScpInitialRadius : { return scp_initial_radius_; }
+      case SolverDoubleParam_ScpStepTolerance : { return scp_step_tolerance_; }
+      case SolverDoubleParam_ScpViolationTolerance : { return scp_violation_tolerance_; }
+
+      // Augmented Lagrangian parameters
+      case SolverDoubleParam_AugLagFeasibilityTol : { return al_feasibility_tolerance_; }
+      case SolverDoubleParam_AugLagOptimalityTol : { return al_optimality_tolerance_; }
+      case SolverDoubleParam_AugLagInitialPenalty : { return al_initial_penalty_; }
+      case SolverDoubleParam_AugLagPenaltyGrowth : { return al_penalty_growth_; }
 
       // Not handled parameters
       default: { throw std::runtime_error("SolverSetting::get SolverDoubleParam invalid"); break; }
@@ -224,15 +270,51 @@ namespace solver {
       case SolverDoubleParam_StepLengthScaling : { step_length_scaling_ = value; break; }
       case SolverDoubleParam_MinimumCenteringStep : { min_centering_step_ = value; break; }
       case SolverDoubleParam_MaximumCenteringStep : { max_centering_step_ = value; break; }
+      case SolverDoubleParam_CorrectorStepIncrease : { corrector_step_increase_ = value; break; }
+      case SolverDoubleParam_CorrectorAcceptance : { corrector_acceptance_ = value; break; }
 
       // Model parameters
       case SolverDoubleParam_TrustRegionThreshold : { trust_region_threshold_ = value; break; }
       case SolverDoubleParam_SoftConstraintWeightFull : { soft_constraint_weight_full_ = value; break; }
       case SolverDoubleParam_SoftConstraintWeightReduced : { soft_constraint_weight_reduced_ = value; break; }
+      case SolverDoubleParam_ScpInitialRadius : { scp_initial_radius_ = value; break; }
+      case SolverDoubleParam_ScpStepTolerance : { scp_step_tolerance_ = value; break; }
+      case SolverDoubleParam_ScpViolationTolerance : { scp_violation_tolerance_ = value; break; }
+
+      // Augmented Lagrangian parameters
+      case SolverDoubleParam_AugLagFeasibilityTol : { al_feasibility_tolerance_ = value; break; }
+      case SolverDoubleParam_AugLagOptimalityTol : { al_optimality_tolerance_ = value; break; }
+      case SolverDoubleParam_AugLagInitialPenalty : { al_initial_penalty_ = value; break; }
+      case SolverDoubleParam_AugLagPenaltyGrowth : { al_penalty_growth_ = value; break; }
 
       // Not handled parameters
       default: { throw std::runtime_error("SolverSetting::set SolverDoubleParam invalid"); break; }
     }
   }
 
+  // getter and setter methods for string parameters
+  const std::string& SolverSetting::get(SolverStringParam param) const
+  {
+    switch (param)
+    {
+      // Linear System parameters
+      case SolverStringParam_OrderingCacheDir : { return ordering_cache_dir_; }
+
+      // Not handled parameters
+      default: { throw std::runtime_error("SolverSetting::get SolverStringParam invalid"); break; }
+    }
+  }
+
+  void SolverSetting::set(SolverStringParam param, const std::string& value)
+  {
+    switch (param)
+    {
+      // Linear System parameters
+      case SolverStringParam_OrderingCacheDir : { ordering_cache_dir_ = value; break; }
+
+      // Not handled parameters
+      default: { throw std::runtime_error("SolverSetting::set SolverStringParam invalid"); break; }
+    }
+  }
+
 }
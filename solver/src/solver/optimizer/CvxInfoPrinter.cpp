@@ -9,8 +9,7 @@
  * Modified to c++ code by New York University and Max Planck Gesellschaft, 2017 
  */
 
-#include <iomanip>
-#include <iostream>
+#include <algorithm>
 #include <solver/optimizer/CvxInfoPrinter.hpp>
 
 namespace solver {
@@ -31,6 +30,8 @@ namespace solver {
       this->get(SolverDoubleParam_DualInfeasibility) = other.get(SolverDoubleParam_DualInfeasibility);
       this->get(SolverDoubleParam_RelativeDualityGap) = other.get(SolverDoubleParam_RelativeDualityGap);
       this->get(SolverDoubleParam_PrimalInfeasibility) = other.get(SolverDoubleParam_PrimalInfeasibility);
+      this->get(SolverDoubleParam_NonconvexViolation) = other.get(SolverDoubleParam_NonconvexViolation);
+      this->get(SolverIntParam_NumScpRefinements) = other.get(SolverIntParam_NumScpRefinements);
     }
     return *this;
   }
@@ -77,6 +78,7 @@ namespace solver {
       case SolverDoubleParam_RelativeDualityGap : { return relative_duality_gap_; }
       case SolverDoubleParam_PrimalInfeasibility : { return primal_infeasibility_; }
       case SolverDoubleParam_CorrectionStepLength : { return correction_step_length_; }
+      case SolverDoubleParam_NonconvexViolation : { return nonconvex_violation_; }
       default: { throw std::runtime_error("OptimizationInfo::get SolverDoubleParam invalid"); break; }
     }
   }
@@ -100,6 +102,7 @@ namespace solver {
       case SolverDoubleParam_RelativeDualityGap : { return relative_duality_gap_; }
       case SolverDoubleParam_PrimalInfeasibility : { return primal_infeasibility_; }
       case SolverDoubleParam_CorrectionStepLength : { return correction_step_length_; }
+      case SolverDoubleParam_NonconvexViolation : { return nonconvex_violation_; }
       default: { throw std::runtime_error("OptimizationInfo::get SolverDoubleParam invalid"); break; }
     }
   }
@@ -113,6 +116,7 @@ namespace solver {
       case SolverIntParam_NumRefsLinSolve : { return linear_solve_refinements_; }
       case SolverIntParam_NumRefsLinSolveAffine : { return affine_linear_solve_refinements_; }
       case SolverIntParam_NumRefsLinSolveCorrector : { return correction_linear_solve_refinements_; }
+      case SolverIntParam_NumScpRefinements : { return scp_refinements_; }
       default: { throw std::runtime_error("OptimizationInfo::get SolverIntParam invalid"); break; }
     }
   }
@@ -125,11 +129,20 @@ namespace solver {
       case SolverIntParam_NumRefsLinSolve : { return linear_solve_refinements_; }
       case SolverIntParam_NumRefsLinSolveAffine : { return affine_linear_solve_refinements_; }
       case SolverIntParam_NumRefsLinSolveCorrector : { return correction_linear_solve_refinements_; }
+      case SolverIntParam_NumScpRefinements : { return scp_refinements_; }
       default: { throw std::runtime_error("OptimizationInfo::get SolverIntParam invalid"); break; }
     }
   }
 
   // CvxInfoPrinter class
+  void CvxInfoPrinter::initialize(const std::shared_ptr<const SolverSetting>& stgs)
+  {
+    stgs_ = stgs;
+
+    // progress lines of all iterations, header and closing messages
+    if (stgs_->get(SolverBoolParam_Verbose)) { sink_.reserve(stgs_->get(SolverIntParam_SolverMaxIters)+8); }
+  }
+
   void CvxInfoPrinter::display(const Msg& msg, const OptimizationInfo& info)
   {
     if (stgs_->get(SolverBoolParam_Verbose)) {
@@ -137,94 +150,74 @@ namespace solver {
       {
         case Msg::MatrixFactorization:
         {
-          std::cout << "Matrix factorization problem" << std::endl;
+          sink_.write("Matrix factorization problem\n");
           break;
         }
         case Msg::SearchDirection:
         {
-          std::cout << "Unreliable search direction, recovering best iterate " << info.get(SolverIntParam_NumIter) << std::endl << std::endl;
+          sink_.write("Unreliable search direction, recovering best iterate %d\n\n", info.get(SolverIntParam_NumIter));
           break;
         }
         case Msg::NumericalProblem:
         {
-          std::cout << "Numerical Problems " << std::setprecision(3)
-                    << " (Feasibility = " << std::max(info.get(SolverDoubleParam_DualResidual), info.get(SolverDoubleParam_PrimalResidual))
-                    << ", RelGap = " << info.get(SolverDoubleParam_RelativeDualityGap)
-                    << ", AbsGap = " << info.get(SolverDoubleParam_DualityGap) << ")" << std::endl << std::endl;
+          sink_.write("Numerical Problems  (Feasibility = %.3e, RelGap = %.3e, AbsGap = %.3e)\n\n",
+                      std::max(info.get(SolverDoubleParam_DualResidual), info.get(SolverDoubleParam_PrimalResidual)),
+                      info.get(SolverDoubleParam_RelativeDualityGap), info.get(SolverDoubleParam_DualityGap));
           break;
         }
         case Msg::LineSearchStagnation:
         {
-          std::cout << "Line search stagnation, recovering best iterate " << info.get(SolverIntParam_NumIter) << std::endl << std::endl;
+          sink_.write("Line search stagnation, recovering best iterate %d\n\n", info.get(SolverIntParam_NumIter));
           break;
         }
         case Msg::VariablesLeavingCone:
         {
-          std::cout << "Variables outside cone, recovering best iterate " << info.get(SolverIntParam_NumIter) << std::endl << std::endl;
+          sink_.write("Variables outside cone, recovering best iterate %d\n\n", info.get(SolverIntParam_NumIter));
           break;
         }
         case Msg::MaxItersReached:
         {
-          std::cout << "Max number of iterations reached " << std::setprecision(3)
-                    << " (Feasibility = " << std::max(info.get(SolverDoubleParam_DualResidual), info.get(SolverDoubleParam_PrimalResidual))
-                    << ", RelGap = " << info.get(SolverDoubleParam_RelativeDualityGap)
-                    << ", AbsGap = " << info.get(SolverDoubleParam_DualityGap) << ")" << std::endl << std::endl;
+          sink_.write("Max number of iterations reached  (Feasibility = %.3e, RelGap = %.3e, AbsGap = %.3e)\n\n",
+                      std::max(info.get(SolverDoubleParam_DualResidual), info.get(SolverDoubleParam_PrimalResidual)),
+                      info.get(SolverDoubleParam_RelativeDualityGap), info.get(SolverDoubleParam_DualityGap));
           break;
         }
         case Msg::OptimalityReached:
         {
-          std::cout << std::endl << (info.mode()==PrecisionConvergence::Full ? "OPTIMAL" : "Close to OPTIMAL") << std::scientific << std::setprecision(3)
-                    << " (Feasibility = " << std::max(info.get(SolverDoubleParam_DualResidual), info.get(SolverDoubleParam_PrimalResidual))
-                    << ", RelGap = " << info.get(SolverDoubleParam_RelativeDualityGap)
-                    << ", AbsGap = " << info.get(SolverDoubleParam_DualityGap) << ")" << std::endl << std::endl;
+          sink_.write("\n%s (Feasibility = %.3e, RelGap = %.3e, AbsGap = %.3e)\n\n",
+                      info.mode()==PrecisionConvergence::Full ? "OPTIMAL" : "Close to OPTIMAL",
+                      std::max(info.get(SolverDoubleParam_DualResidual), info.get(SolverDoubleParam_PrimalResidual)),
+                      info.get(SolverDoubleParam_RelativeDualityGap), info.get(SolverDoubleParam_DualityGap));
           break;
         }
         case Msg::PrimalInfeasibility:
         {
-          std::cout << std::endl << (info.mode()==PrecisionConvergence::Full ? "PRIMAL INFEASIBLE" : "Close to PRIMAL INFEASIBLE") << std::scientific << std::setprecision(3)
-                    << " (Feasibility = " << info.get(SolverDoubleParam_PrimalInfeasibility) << ")" << std::endl << std::endl;
+          sink_.write("\n%s (Feasibility = %.3e)\n\n", info.mode()==PrecisionConvergence::Full ? "PRIMAL INFEASIBLE" : "Close to PRIMAL INFEASIBLE",
+                      info.get(SolverDoubleParam_PrimalInfeasibility));
           break;
         }
         case Msg::DualInfeasibility:
         {
-          std::cout << std::endl << (info.mode()==PrecisionConvergence::Full ? "DUAL INFEASIBLE" : "Close to DUAL INFEASIBLE") << std::scientific << std::setprecision(3)
-                    << " (Feasibility = " << info.get(SolverDoubleParam_DualInfeasibility) << ")" << std::endl << std::endl;
+          sink_.write("\n%s (Feasibility = %.3e)\n\n", info.mode()==PrecisionConvergence::Full ? "DUAL INFEASIBLE" : "Close to DUAL INFEASIBLE",
+                      info.get(SolverDoubleParam_DualInfeasibility));
           break;
         }
         case Msg::OptimizationProgress:
         {
           if (info.get(SolverIntParam_NumIter)==0) {
-            std::cout << std::endl
-                      << " =============================== OPTIMIZATION PROGRESS =============================== " << std::endl << std::endl;
-            std::cout << "It        pcost       dcost      gap   pres   dres    k/t    mu     step   sigma     IR" << std::endl;
-            std::cout << std::scientific << std::setw(4)  << info.get(SolverIntParam_NumIter)
-                                         << std::setw(12) << std::setprecision(3) << info.get(SolverDoubleParam_PrimalCost)
-                                         << std::setw(12) << std::setprecision(3) << info.get(SolverDoubleParam_DualCost)
-                                         << std::setw(8)  << std::setprecision(0) << info.get(SolverDoubleParam_DualityGap)
-                                         << std::setw(7)  << std::setprecision(0) << info.get(SolverDoubleParam_PrimalResidual)
-                                         << std::setw(7)  << std::setprecision(0) << info.get(SolverDoubleParam_DualResidual)
-                                         << std::setw(7)  << std::setprecision(0) << info.get(SolverDoubleParam_KappaOverTau)
-                                         << std::setw(7)  << std::setprecision(0) << info.get(SolverDoubleParam_StepLength)
-                      << std::fixed      << std::setw(8)  << std::setprecision(4) << "--- "
-                      << std::scientific << std::setw(7)  << std::setprecision(0) << "--- "
-                      << std::fixed      << std::setw(4)  << std::setprecision(0) << info.get(SolverIntParam_NumRefsLinSolve)
-                                         << std::setw(3)  << std::setprecision(0) << info.get(SolverIntParam_NumRefsLinSolveAffine)
-                                         << std::setw(3)  << std::setprecision(0) << "-" << std::endl;
-
+            sink_.write("\n =============================== OPTIMIZATION PROGRESS =============================== \n\n");
+            sink_.write("It        pcost       dcost      gap   pres   dres    k/t    mu     step   sigma     IR\n");
+            sink_.write("%4d%12.3e%12.3e%8.0e%7.0e%7.0e%7.0e%7.0e%8s%7s%4d%3d%3s\n", info.get(SolverIntParam_NumIter),
+                        info.get(SolverDoubleParam_PrimalCost), info.get(SolverDoubleParam_DualCost), info.get(SolverDoubleParam_DualityGap),
+                        info.get(SolverDoubleParam_PrimalResidual), info.get(SolverDoubleParam_DualResidual), info.get(SolverDoubleParam_KappaOverTau),
+                        info.get(SolverDoubleParam_StepLength), "--- ", "--- ", info.get(SolverIntParam_NumRefsLinSolve),
+                        info.get(SolverIntParam_NumRefsLinSolveAffine), "-");
           } else {
-            std::cout << std::scientific << std::setw(4)  << info.get(SolverIntParam_NumIter)
-                                         << std::setw(12) << std::setprecision(3) << info.get(SolverDoubleParam_PrimalCost)
-                                         << std::setw(12) << std::setprecision(3) << info.get(SolverDoubleParam_DualCost)
-                                         << std::setw(8)  << std::setprecision(0) << info.get(SolverDoubleParam_DualityGap)
-                                         << std::setw(7)  << std::setprecision(0) << info.get(SolverDoubleParam_PrimalResidual)
-                                         << std::setw(7)  << std::setprecision(0) << info.get(SolverDoubleParam_DualResidual)
-                                         << std::setw(7)  << std::setprecision(0) << info.get(SolverDoubleParam_KappaOverTau)
-                                         << std::setw(7)  << std::setprecision(0) << info.get(SolverDoubleParam_MeritFunction)
-                      << std::fixed      << std::setw(8)  << std::setprecision(4) << info.get(SolverDoubleParam_StepLength)
-                      << std::scientific << std::setw(7)  << std::setprecision(0) << info.get(SolverDoubleParam_CorrectionStepLength)
-                      << std::fixed      << std::setw(4)  << std::setprecision(0) << info.get(SolverIntParam_NumRefsLinSolve)
-                                         << std::setw(3)  << std::setprecision(0) << info.get(SolverIntParam_NumRefsLinSolveAffine)
-                                         << std::setw(3)  << std::setprecision(0) << info.get(SolverIntParam_NumRefsLinSolveCorrector) << std::endl;
+            sink_.write("%4d%12.3e%12.3e%8.0e%7.0e%7.0e%7.0e%7.0e%8.4f%7.0e%4d%3d%3d\n", info.get(SolverIntParam_NumIter),
+                        info.get(SolverDoubleParam_PrimalCost), info.get(SolverDoubleParam_DualCost), info.get(SolverDoubleParam_DualityGap),
+                        info.get(SolverDoubleParam_PrimalResidual), info.get(SolverDoubleParam_DualResidual), info.get(SolverDoubleParam_KappaOverTau),
+                        info.get(SolverDoubleParam_MeritFunction), info.get(SolverDoubleParam_StepLength), info.get(SolverDoubleParam_CorrectionStepLength),
+                        info.get(SolverIntParam_NumRefsLinSolve), info.get(SolverIntParam_NumRefsLinSolveAffine), info.get(SolverIntParam_NumRefsLinSolveCorrector));
           }
           break;
         }
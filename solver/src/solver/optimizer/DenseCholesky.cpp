@@ -0,0 +1,103 @@
+/**
+ * @file DenseCholesky.cpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#include <solver/optimizer/DenseCholesky.hpp>
+
+namespace linalg {
+
+  void DenseCholesky::analyzePattern(const Eigen::SparseMatrix<double>& mat, const solver::SolverSetting& setting)
+  {
+    n_ = mat.cols();
+    L_.resize(n_,n_);
+    D_.resize(n_);
+    delta_ = setting.get(solver::SolverDoubleParam_DynamicRegularization);
+    eps_ = setting.get(solver::SolverDoubleParam_DynamicRegularizationThresh);
+  }
+
+  double DenseCholesky::factorFlops() const
+  {
+    double flops = 0.0;
+    for (int j=0; j<n_; j++) { flops += double(n_-j-1)*(n_-j+2.0); }
+    return flops;
+  }
+
+  int DenseCholesky::factorize(const Eigen::SparseMatrix<double>& mat, const Eigen::Ref<const Eigen::VectorXd>& sign)
+  {
+    // lower triangle of the workspace holds the transposed upper triangle of the matrix
+    L_.setZero();
+    const double* Ax = mat.valuePtr();
+    const int* Ap = mat.outerIndexPtr();
+    const int* Ai = mat.innerIndexPtr();
+    for (int col=0; col<n_; col++)
+      for (int p=Ap[col]; p<Ap[col+1]; p++)
+        L_(col, Ai[p]) = Ax[p];
+
+    // right-looking factorization, zero multipliers are skipped so that sparse columns stay cheap
+    for (int j=0; j<n_; j++) {
+      double* colj = L_.col(j).data();
+
+      // Dynamic regularization
+      D_[j] = sign[j]*colj[j] <= eps_ ? sign[j]*delta_ : colj[j];
+      for (int i=j+1; i<n_; i++) { colj[i] /= D_[j]; }
+
+      for (int k=j+1; k<n_; k++) {
+        if (colj[k]==0.0) { continue; }
+        double l_kd = colj[k]*D_[j];
+        double* colk = L_.col(k).data();
+        for (int i=k; i<n_; i++) { colk[i] -= colj[i]*l_kd; }
+      }
+      colj[j] = 1.0;
+    }
+    return n_;
+  }
+
+  void DenseCholesky::solve(const Eigen::Ref<const Eigen::VectorXd>& b, double* x)
+  {
+    Eigen::Map<Eigen::VectorXd> eig_x(x, n_);
+    eig_x = b;
+    for (int j=0; j<n_; j++) {
+      if (x[j]==0.0) { continue; }
+      const double* colj = L_.col(j).data();
+      for (int i=j+1; i<n_; i++) { x[i] -= colj[i]*x[j]; }
+    }
+
+    for (int j=0; j<n_; j++) { x[j] /= D_[j]; }
+
+    for (int j=n_-1; j>=0; j--) {
+      const double* colj = L_.col(j).data();
+      for (int i=j+1; i<n_; i++) { x[j] -= colj[i]*x[i]; }
+    }
+  }
+
+  void DenseCholesky::solve(Eigen::Ref<Eigen::MatrixXd> eig_x)
+  {
+    // several right hand sides share one pass over the factor
+    double* x = eig_x.data();
+    int nrhs = eig_x.cols(), ld = eig_x.outerStride();
+    for (int j=0; j<n_; j++) {
+      const double* colj = L_.col(j).data();
+      for (int k=0; k<nrhs; k++) {
+        double* xk = x+k*ld;
+        if (xk[j]==0.0) { continue; }
+        for (int i=j+1; i<n_; i++) { xk[i] -= colj[i]*xk[j]; }
+      }
+    }
+
+    for (int k=0; k<nrhs; k++)
+      for (int j=0; j<n_; j++) { x[j+k*ld] /= D_[j]; }
+
+    for (int j=n_-1; j>=0; j--) {
+      const double* colj = L_.col(j).data();
+      for (int k=0; k<nrhs; k++) {
+        double* xk = x+k*ld;
+        for (int i=j+1; i<n_; i++) { xk[j] -= colj[i]*xk[i]; }
+      }
+    }
+  }
+
+}
@@ -17,23 +17,23 @@ namespace solver {
   {
     equil_vec_.initialize(cone);
     cone_ = std::make_shared<Cone>(cone);
-    stgs_ = std::make_shared<SolverSetting>(stgs);
-    this->ruizEquilibration(stg);
+    this->ruizEquilibration(stg, stgs.get(SolverIntParam_EquilibrationIters));
   }
 
-  void EqRoutine::ruizEquilibration(SolverStorage& stg)
+  void EqRoutine::ruizEquilibration(SolverStorage& stg, int num_iters)
   {
     Vector equil_tmp;
     equil_vec_.setOnes();
     equil_tmp.initialize(*cone_);
 
     // iterative equilibration
-    for (int iter=0; iter<stgs_->get(SolverIntParam_EquilibrationIters); iter++) {
+    for (int iter=0; iter<num_iters; iter++) {
       equil_tmp.setZero();
 
       // infinity norms of rows and columns of optimization matrices
       if (stg.Amatrix().nonZeros()>0) { maxRowsCols(equil_tmp.y().data(), equil_tmp.x().data(), stg.Amatrix()); }
       if (stg.Gmatrix().nonZeros()>0) { maxRowsCols(equil_tmp.z().data(), equil_tmp.x().data(), stg.Gmatrix()); }
+      if (cone_->sizeBox()>0) { maxBoxRowsCols(equil_tmp.z().data(), equil_tmp.x().data(), stg); }
 
       // equilibration of second order cones
       for (int i=0; i<cone_->numSoc(); i++) { equil_tmp.zSoc(i).setConstant( equil_tmp.zSoc(i).sum() ); }
@@ -42,6 +42,7 @@ namespace solver {
       // matrices equilibration
       if (stg.Amatrix().nonZeros()>0) { equilibrateRowsCols(equil_tmp.y().data(), equil_tmp.x().data(), stg.Amatrix()); }
       if (stg.Gmatrix().nonZeros()>0) { equilibrateRowsCols(equil_tmp.z().data(), equil_tmp.x().data(), stg.Gmatrix()); }
+      if (cone_->sizeBox()>0) { equilibrateBox(equil_tmp.z().data(), equil_tmp.x().data(), stg); }
 
       // update equilibration vector
       equil_vec_.array() *= equil_tmp.array();
@@ -62,6 +63,26 @@ namespace solver {
     }
   }
 
+  void EqRoutine::maxBoxRowsCols(double *row_vec, double *col_vec, const SolverStorage& stg)
+  {
+    for (int row=0; row<cone_->sizeBox(); row++) {
+      row_vec[row] = fabs(stg.boxCoeff()[row]);
+      col_vec[stg.boxIndex()[row]] = std::max(row_vec[row], col_vec[stg.boxIndex()[row]]);
+    }
+  }
+
+  void EqRoutine::equilibrateBox(const double *row_vec, const double *col_vec, SolverStorage& stg)
+  {
+    for (int row=0; row<cone_->sizeBox(); row++)
+      stg.boxCoeff()[row] /= (col_vec[stg.boxIndex()[row]] * row_vec[row]);
+  }
+
+  void EqRoutine::unequilibrateBox(const double *row_vec, const double *col_vec, SolverStorage& stg)
+  {
+    for (int row=0; row<cone_->sizeBox(); row++)
+      stg.boxCoeff()[row] *= (row_vec[row] * col_vec[stg.boxIndex()[row]]);
+  }
+
   void EqRoutine::equilibrateRowsCols(const double *row_vec, const double *col_vec, Eigen::SparseMatrix<double>& mat)
   {
     for (int k=0; k<mat.outerSize(); ++k)
@@ -73,6 +94,7 @@ namespace solver {
   {
     if (stg.Amatrix().nonZeros()>0) { unequilibrateRowsCols(equil_vec_.y().data(), equil_vec_.x().data(), stg.Amatrix()); }
     if (stg.Gmatrix().nonZeros()>0) { unequilibrateRowsCols(equil_vec_.z().data(), equil_vec_.x().data(), stg.Gmatrix()); }
+    if (cone_->sizeBox()>0) { unequilibrateBox(equil_vec_.z().data(), equil_vec_.x().data(), stg); }
     stg.cbh().array() *= equil_vec_.array();
   }
 
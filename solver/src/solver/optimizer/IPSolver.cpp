@@ -9,6 +9,7 @@
  * Modified to c++ code by New York University and Max Planck Gesellschaft, 2017 
  */
 
+#include <iostream>
 #include <solver/optimizer/IPSolver.hpp>
 
 namespace solver {
@@ -25,12 +26,12 @@ namespace solver {
     this->getStorage().h()[id] = value / equilibration_routine_.equilVec().z()[id];
   }
 
-  void InteriorPointSolver::initialize(SolverStorage& storage, Cone& cone, SolverSetting& setting)
+  void InteriorPointSolver::initialize(SolverStorage& storage, Cone& cone, const SolverSetting& setting)
   {
-    // setup problem
+    // setup problem, later changes of the setting apply from the next initialization
     cone_ = &cone;
     storage_ = &storage;
-    setting_ = &setting;
+    setting_ = std::make_shared<const SolverSetting>(setting);
     current_iter = 0;
     this->internalInitialization();
   }
@@ -38,13 +39,11 @@ namespace solver {
   void InteriorPointSolver::internalInitialization()
   {
     // setup message printer
-    this->getPrinter().initialize(this->getSetting());
+    this->getPrinter().initialize(setting_);
 
     // equilibration of problem data
     this->getEqRoutine().setEquilibration(this->getCone(), this->getSetting(), this->getStorage());
-    this->getStorage().Atmatrix() = this->getStorage().Amatrix().transpose();
-    this->getStorage().Gtmatrix() = this->getStorage().Gmatrix().transpose();
-    this->getLinSolver().initialize(this->getCone(), this->getSetting(), this->getStorage());
+    this->getLinSolver().initialize(this->getCone(), setting_, this->getStorage());
 
     // initialize problem variables
     rho_.initialize(this->getCone());
@@ -55,6 +54,7 @@ namespace solver {
     lbar_.initialize(this->getCone());
     dopt1_.initialize(this->getCone());
     dopt2_.initialize(this->getCone());
+    dopt3_.initialize(this->getCone());
     sigma_.initialize(this->getCone());
     lambda_.initialize(this->getCone());
     best_opt_.initialize(this->getCone());
@@ -62,6 +62,8 @@ namespace solver {
     dz_combined_.initialize(this->getCone());
     ds_affine_by_W_.initialize(this->getCone());
     W_times_dz_affine_.initialize(this->getCone());
+    ds_prev_by_W_.initialize(this->getCone());
+    W_times_dz_prev_.initialize(this->getCone());
   }
 
   ExitCode InteriorPointSolver::initializeVariables()
@@ -88,15 +90,16 @@ namespace solver {
         rhs1_[invPerm[this->getCone().extStartSoc(l)+i]] = this->getStorage().cbh()[this->getCone().optStartSoc(l)+i];
     }
 
-    this->getInfo().get(SolverIntParam_NumRefsLinSolve) = this->getLinSolver().solve(rhs1_, dopt2_, true);
+    // right hand side of dual variables, both systems are solved together
+    for (int i=0; i<this->getCone().numVars(); i++){ rhs2_[invPerm[i]] = -this->getStorage().c()[i]; }
+
+    this->getLinSolver().solve(rhs1_, dopt2_, this->getInfo().get(SolverIntParam_NumRefsLinSolve),
+                               rhs2_, dopt1_, this->getInfo().get(SolverIntParam_NumRefsLinSolveAffine));
     opt_.x() = dopt2_.x();
     opt_.s() = -dopt2_.z();
     this->getCone().conicProjection(opt_.s());
 
     // initialize dual variables
-    for (int i=0; i<this->getCone().numVars(); i++){ rhs2_[invPerm[i]] = -this->getStorage().c()[i]; }
-
-    this->getInfo().get(SolverIntParam_NumRefsLinSolveAffine) = this->getLinSolver().solve(rhs2_, dopt1_, true);
     opt_.y() = dopt1_.y();
     opt_.z() = dopt1_.z();
     this->getCone().conicProjection(opt_.z());
@@ -113,12 +116,14 @@ namespace solver {
   {
     this->getLinSolver().matrixTransposeTimesVector(this->getStorage().Amatrix(), opt_.y(), res_.x(), false, true);
     this->getLinSolver().matrixTransposeTimesVector(this->getStorage().Gmatrix(), opt_.z(), res_.x(), false, false);
+    this->getLinSolver().boxTransposeTimesVector(opt_.z(), res_.x(), false);
     residual_x_ = res_.x().norm();
 
-    this->getLinSolver().matrixTransposeTimesVector(this->getStorage().Atmatrix(), opt_.x(), res_.y(), true, true);
+    this->getLinSolver().matrixTimesVector(this->getStorage().Amatrix(), opt_.x(), res_.y(), true, true);
     residual_y_ = res_.y().norm();
 
-    this->getLinSolver().matrixTransposeTimesVector(this->getStorage().Gtmatrix(), opt_.x(), res_.z(), true, true);
+    this->getLinSolver().matrixTimesVector(this->getStorage().Gmatrix(), opt_.x(), res_.z(), true, true);
+    this->getLinSolver().boxTimesVector(opt_.x(), res_.z(), true);
     res_.z() += opt_.s();
     residual_z_ = res_.z().norm();
 
@@ -228,7 +233,6 @@ namespace solver {
       reltol  = this->getSetting().get(SolverDoubleParam_DualityGapRelTol);
       //std::cout << "accurate" << std::endl;
     } else {
-      std::cout << "inaccurate" << std::endl;
       feastol = this->getSetting().get(SolverDoubleParam_FeasibilityTolInacc);
       abstol  = this->getSetting().get(SolverDoubleParam_DualityGapAbsTolInacc);
       reltol  = this->getSetting().get(SolverDoubleParam_DualityGapRelTolInacc);
@@ -280,14 +284,17 @@ namespace solver {
     }
   }
 
-  void InteriorPointSolver::rhsCenteringPredictorStep()
+  void InteriorPointSolver::rhsCenteringPredictorStep(bool scale_residuals)
   {
     double* dz_combined_ptr = dz_combined_.data();
     const int* invPerm = this->getLinSolver().invPerm().indices().data();
     double factor = 1.0 - this->getInfo().get(SolverDoubleParam_CorrectionStepLength);
 
-    for (int i=0; i<this->getCone().numVars(); i++) { rhs2_[invPerm[i]] *= factor; }
-    for (int i=0; i<this->getCone().numLeq(); i++ ) { rhs2_[invPerm[this->getCone().numVars()+i]] *= factor; }
+    // residuals of x and y are scaled once, correctors only change the cone rows
+    if (scale_residuals) {
+      for (int i=0; i<this->getCone().numVars(); i++) { rhs2_[invPerm[i]] *= factor; }
+      for (int i=0; i<this->getCone().numLeq(); i++ ) { rhs2_[invPerm[this->getCone().numVars()+i]] *= factor; }
+    }
     for (int i=0; i<this->getCone().sizeLpc(); i++) { rhs2_[invPerm[this->getCone().lpConeStart()+i]] = dz_combined_ptr[i]; }
     for (int l=0; l < this->getCone().numSoc(); l++ ){
       for (int i=0; i<this->getCone().sizeSoc(l); i++)
@@ -295,7 +302,68 @@ namespace solver {
     }
   }
 
+  double InteriorPointSolver::combinedStep(bool is_corrector)
+  {
+    // search direction for the complementarity targets in ds_combined_
+    ds_affine_by_W_ = lambda_/ds_combined_;
+    dz_combined_ = (this->getInfo().get(SolverDoubleParam_CorrectionStepLength)-1.0)*res_.z() + this->getCone().W()*ds_affine_by_W_;
+
+    rhsCenteringPredictorStep(!is_corrector);
+    this->getInfo().get(SolverIntParam_NumRefsLinSolveCorrector) = this->getLinSolver().solve(rhs2_, dopt1_);
+
+    dopt1_.tau() = ((1-this->getInfo().get(SolverDoubleParam_CorrectionStepLength))*this->residual_t_ - dk_combined_/this->opt_.tau() + dotProduct(this->getCone().numVars(), this->getStorage().c().data(), dopt1_.x().data()) + dotProduct(this->getCone().numLeq(), this->getStorage().b().data(), dopt1_.y().data()) + dotProduct(this->getCone().sizeCone(), this->getStorage().h().data(), dopt1_.z().data())) / dt_denom_;
+    dopt1_.xyz() += dopt1_.tau()*dopt2_.xyz();
+    W_times_dz_affine_ = this->getCone().W()*dopt1_.z();
+    for (int i=0; i<this->getCone().sizeCone(); i++) { ds_affine_by_W_[i] = -(ds_affine_by_W_[i] + W_times_dz_affine_[i]); }
+    dopt1_.kappa() = -(dk_combined_ + this->opt_.kappa()*dopt1_.tau())/this->opt_.tau();
+    return lineSearch(ds_affine_by_W_, W_times_dz_affine_, this->opt_.tau(), dopt1_.tau(), this->opt_.kappa(), dopt1_.kappa());
+  }
+
+  double InteriorPointSolver::centralityCorrectors(double step_length)
+  {
+    // complementarity products outside [beta_min, beta_max]*sigma*mu are pushed back
+    const double beta_min = 0.1, beta_max = 10.0;
+    double target_mu = this->getInfo().get(SolverDoubleParam_CorrectionStepLength)*this->getInfo().get(SolverDoubleParam_MeritFunction);
+    double step_increase = this->getSetting().get(SolverDoubleParam_CorrectorStepIncrease);
+
+    for (int corrector=0; corrector<this->getSetting().get(SolverIntParam_MaxCentralityCorrectors); corrector++)
+    {
+      if (step_length >= this->getSetting().get(SolverDoubleParam_MaximumStepLength)) { break; }
+
+      // products of the scaled slacks and multipliers at an enlarged trial step,
+      // only linear cones are corrected as products of second order cones are not componentwise
+      double trial_step = std::min((1.0+step_increase)*step_length, 1.0);
+      for (int i=0; i<this->getCone().sizeLpc(); i++) {
+        double product = (lambda_[i]+trial_step*ds_affine_by_W_[i])*(lambda_[i]+trial_step*W_times_dz_affine_[i]);
+        if      (product < beta_min*target_mu) { ds_combined_[i] -= beta_min*target_mu-product; }
+        else if (product > beta_max*target_mu) { ds_combined_[i] -= std::max(beta_max*target_mu-product, -beta_max*target_mu); }
+      }
+
+      // the corrected direction is kept only if it lengthens the step enough
+      dopt3_ = dopt1_;
+      ds_prev_by_W_ = ds_affine_by_W_;
+      W_times_dz_prev_ = W_times_dz_affine_;
+      double corrected_step_length = this->combinedStep(true);
+      if (corrected_step_length < (1.0+this->getSetting().get(SolverDoubleParam_CorrectorAcceptance)*step_increase)*step_length) {
+        dopt1_ = dopt3_;
+        ds_affine_by_W_ = ds_prev_by_W_;
+        W_times_dz_affine_ = W_times_dz_prev_;
+        break;
+      }
+      step_length = corrected_step_length;
+    }
+    return step_length;
+  }
+
   ExitCode InteriorPointSolver::optimize()
+  {
+    // messages are printed once the iterations are over
+    ExitCode exitcode = this->iterate();
+    this->getPrinter().sink().drain(std::cout);
+    return exitcode;
+  }
+
+  ExitCode InteriorPointSolver::iterate()
   {
     prev_pres_ = SolverSetting::nan;
     exitcode_ = ExitCode::Indeterminate;
@@ -374,11 +442,11 @@ namespace solver {
         this->getPrinter().display(Msg::MatrixFactorization, this->getInfo());
         return ExitCode::Indeterminate;
       }
-      this->getInfo().get(SolverIntParam_NumRefsLinSolve) = this->getLinSolver().solve(rhs1_, dopt2_);
 
-      // Affine Step
+      // Affine Step, solved together with the system of rhs1
       rhsAffineStep();
-      this->getInfo().get(SolverIntParam_NumRefsLinSolveAffine) = this->getLinSolver().solve(rhs2_, dopt1_);
+      this->getLinSolver().solve(rhs1_, dopt2_, this->getInfo().get(SolverIntParam_NumRefsLinSolve),
+                                 rhs2_, dopt1_, this->getInfo().get(SolverIntParam_NumRefsLinSolveAffine));
 
       dt_denom_ = opt_.kappa()/opt_.tau() - dotProduct(this->getCone().numVars(), this->getStorage().c().data(), dopt2_.x().data()) - dotProduct(this->getCone().numLeq(), this->getStorage().b().data(), dopt2_.y().data()) - dotProduct(this->getCone().sizeCone(), this->getStorage().h().data(), dopt2_.z().data());
       dt_affine_ = (residual_t_ - opt_.kappa() + dotProduct(this->getCone().numVars(), this->getStorage().c().data(), dopt1_.x().data()) + dotProduct(this->getCone().numLeq(), this->getStorage().b().data(), dopt1_.y().data()) + dotProduct(this->getCone().sizeCone(), this->getStorage().h().data(), dopt1_.z().data())) / dt_denom_;
@@ -392,19 +460,11 @@ namespace solver {
 
       // Centering and Corrector Step
       ds_combined_ = lambda_*lambda_ + ds_affine_by_W_*W_times_dz_affine_- (this->getInfo().get(SolverDoubleParam_CorrectionStepLength)*this->getInfo().get(SolverDoubleParam_MeritFunction));
-      ds_affine_by_W_ = lambda_/ds_combined_;
-      dz_combined_ = (this->getInfo().get(SolverDoubleParam_CorrectionStepLength)-1.0)*res_.z() + this->getCone().W()*ds_affine_by_W_;
       dk_combined_ = this->opt_.kappa()*this->opt_.tau() + dk_affine_*dt_affine_ - this->getInfo().get(SolverDoubleParam_CorrectionStepLength)*this->getInfo().get(SolverDoubleParam_MeritFunction);
 
-      rhsCenteringPredictorStep();
-      this->getInfo().get(SolverIntParam_NumRefsLinSolveCorrector) = this->getLinSolver().solve(rhs2_, dopt1_);
-
-      dopt1_.tau() = ((1-this->getInfo().get(SolverDoubleParam_CorrectionStepLength))*this->residual_t_ - dk_combined_/this->opt_.tau() + dotProduct(this->getCone().numVars(), this->getStorage().c().data(), dopt1_.x().data()) + dotProduct(this->getCone().numLeq(), this->getStorage().b().data(), dopt1_.y().data()) + dotProduct(this->getCone().sizeCone(), this->getStorage().h().data(), dopt1_.z().data())) / dt_denom_;
-      dopt1_.xyz() += dopt1_.tau()*dopt2_.xyz();
-      W_times_dz_affine_ = this->getCone().W()*dopt1_.z();
-      for (int i=0; i<this->getCone().sizeCone(); i++) { ds_affine_by_W_[i] = -(ds_affine_by_W_[i] + W_times_dz_affine_[i]); }
-      dopt1_.kappa() = -(dk_combined_ + this->opt_.kappa()*dopt1_.tau())/this->opt_.tau();
-      this->getInfo().get(SolverDoubleParam_StepLength) = lineSearch(ds_affine_by_W_, W_times_dz_affine_, this->opt_.tau(), dopt1_.tau(), this->opt_.kappa(), dopt1_.kappa()) * this->getSetting().get(SolverDoubleParam_StepLengthScaling);
+      double step_length = this->combinedStep(false);
+      if (this->getSetting().get(SolverIntParam_MaxCentralityCorrectors)>0) { step_length = this->centralityCorrectors(step_length); }
+      this->getInfo().get(SolverDoubleParam_StepLength) = step_length * this->getSetting().get(SolverDoubleParam_StepLengthScaling);
       dopt1_.s() = this->getCone().W()*ds_affine_by_W_;
 
       // Update variables
@@ -69,6 +69,8 @@ licence.
 #include <stdlib.h>
 #include <memory.h>
 #include <stdint.h>
+#include <limits>
+#include <vector>
 #include <algorithm>
 #include <solver/optimizer/LbfgsSolver.hpp>
 
@@ -486,6 +488,298 @@ namespace solver {
     return ret;
   }
 
+  int lbfgsb(int n, double *x, double *ptr_fx, const double *lower, const double *upper,
+    lbfgs_evaluate_t proc_evaluate, lbfgs_progress_t proc_progress, void *instance, lbfgs_parameter_t *_param,
+    lbfgsb_memory_t *memory)
+  {
+    int ret;
+    int i, j, k, b, ls, end, num_pairs, num_cols, num_free;
+    double step, fx = 0., finit, theta = 1.;
+    double xnorm, gnorm, ys, yy, fp, fpp, fpp_min, dt, dt_min, t_old, alpha;
+    const double eps = std::numeric_limits<double>::epsilon();
+
+    /* Constant parameters and their default values. */
+    lbfgs_parameter_t param = (_param != NULL) ? (*_param) : _defparam;
+    const int m = param.m;
+
+    /* Check the input parameters for errors. */
+    if (n <= 0) {
+      return LBFGSERR_INVALID_N;
+    }
+    if (param.epsilon < 0.) {
+      return LBFGSERR_INVALID_EPSILON;
+    }
+    if (param.past < 0) {
+      return LBFGSERR_INVALID_TESTPERIOD;
+    }
+    if (param.delta < 0.) {
+      return LBFGSERR_INVALID_DELTA;
+    }
+    if (param.min_step < 0.) {
+      return LBFGSERR_INVALID_MINSTEP;
+    }
+    if (param.ftol < 0.) {
+      return LBFGSERR_INVALID_FTOL;
+    }
+    if (param.max_linesearch <= 0) {
+      return LBFGSERR_INVALID_MAXLINESEARCH;
+    }
+
+    /* Working space, corrections are stored in a circular buffer of m columns. */
+    Eigen::Map<Eigen::VectorXd> eig_x(x, n);
+    Eigen::Map<const Eigen::VectorXd> eig_l(lower, n), eig_u(upper, n);
+    Eigen::VectorXd g(n), xp(n), gp(n), xcp(n), d(n), t(n), du(n), s(n), y(n), pf(param.past);
+    Eigen::MatrixXd S(n, m), Y(n, m), W(n, 2*m), WF(n, 2*m), middle(2*m, 2*m), M(2*m, 2*m);
+    Eigen::VectorXd p(2*m), c(2*m), wb(2*m), v(2*m);
+    std::vector<int> breakpoints, free_vars;
+    breakpoints.reserve(n);  free_vars.reserve(n);
+
+    /* Start from the stored correction pairs if they match the problem. */
+    end = 0;
+    num_pairs = 0;
+    if (memory != NULL && memory->s.rows() == n && memory->s.cols() == m && 0 < memory->num_pairs) {
+      S = memory->s;
+      Y = memory->y;
+      end = memory->end;
+      theta = memory->theta;
+      num_pairs = memory->num_pairs;
+    }
+
+    /* Start from the projection of the initial point onto the box. */
+    eig_x = eig_x.cwiseMax(eig_l).cwiseMin(eig_u);
+    fx = proc_evaluate(instance, x, g.data(), n, 0);
+    if (0 < param.past) {
+      pf[0] = fx;
+    }
+
+    /* Make sure that the initial variables are not a minimizer. */
+    xnorm = std::max(eig_x.norm(), 1.0);
+    gnorm = ((eig_x-g).cwiseMax(eig_l).cwiseMin(eig_u)-eig_x).norm();
+    if (gnorm / xnorm <= param.epsilon) {
+      ret = LBFGS_ALREADY_MINIMIZED;
+      goto lbfgsb_exit;
+    }
+
+    k = 1;
+    for (;;) {
+      /*
+       *  Compact representation of the hessian approximation:
+       *      B = \theta I - W M W^T,  W = [Y  \theta S],
+       *      M = [-D  L^T; L  \theta S^T S]^{-1},
+       *  with D the diagonal and L the strictly lower triangle of S^T Y.
+       */
+      num_cols = 2*num_pairs;
+      for (i = 0;i < num_pairs;++i) {
+        j = (end + m - num_pairs + i) % m;
+        W.col(i) = Y.col(j);
+        W.col(num_pairs+i) = theta * S.col(j);
+      }
+      if (0 < num_pairs) {
+        middle.topLeftCorner(num_cols, num_cols).setZero();
+        for (i = 0;i < num_pairs;++i) {
+          for (j = 0;j <= i;++j) {
+            ys = W.col(num_pairs+i).dot(W.col(j)) / theta;
+            if (i == j) { middle(i,i) = -ys; }
+            else { middle(num_pairs+i, j) = middle(j, num_pairs+i) = ys; }
+          }
+        }
+        middle.block(num_pairs, num_pairs, num_pairs, num_pairs).noalias() =
+          W.middleCols(num_pairs, num_pairs).transpose() * W.middleCols(num_pairs, num_pairs) / theta;
+        M.topLeftCorner(num_cols, num_cols) = middle.topLeftCorner(num_cols, num_cols).partialPivLu().inverse();
+      }
+      auto Mk = M.topLeftCorner(num_cols, num_cols);
+
+      /*
+       *  Generalized Cauchy point: first local minimizer of the model along
+       *  the projected steepest descent path x(t) = P(x - t g), examined
+       *  segment by segment between the breakpoints where variables hit a bound.
+       */
+      breakpoints.clear();
+      for (i = 0;i < n;++i) {
+        if (g(i) < 0.) { t(i) = (eig_x(i) - eig_u(i)) / g(i); }
+        else if (g(i) > 0.) { t(i) = (eig_x(i) - eig_l(i)) / g(i); }
+        else { t(i) = std::numeric_limits<double>::infinity(); }
+        d(i) = (t(i) == 0.) ? 0. : -g(i);
+        if (0. < t(i) && t(i) < std::numeric_limits<double>::infinity()) { breakpoints.push_back(i); }
+      }
+      std::sort(breakpoints.begin(), breakpoints.end(), [&t](int a, int b) { return t(a) < t(b); });
+
+      xcp = eig_x;
+      p.head(num_cols).noalias() = W.leftCols(num_cols).transpose() * d;
+      c.head(num_cols).setZero();
+      fp = -d.squaredNorm();
+      fpp = -theta * fp - p.head(num_cols).dot(Mk * p.head(num_cols));
+      fpp_min = -eps * theta * fp;
+      dt_min = (fp < 0.) ? -fp / fpp : 0.;
+      t_old = 0.;
+      for (size_t id = 0;id < breakpoints.size();++id) {
+        b = breakpoints[id];
+        dt = t(b) - t_old;
+        if (dt_min < dt) break;
+
+        /* Variable b becomes active, the slope and curvature of the next segment are updated. */
+        xcp(b) = (0. < d(b)) ? eig_u(b) : eig_l(b);
+        c.head(num_cols) += dt * p.head(num_cols);
+        wb.head(num_cols) = W.row(b).head(num_cols).transpose();
+        fp += dt * fpp + g(b) * g(b) + theta * g(b) * (xcp(b) - eig_x(b)) - g(b) * wb.head(num_cols).dot(Mk * c.head(num_cols));
+        fpp -= theta * g(b) * g(b) + 2. * g(b) * wb.head(num_cols).dot(Mk * p.head(num_cols)) + g(b) * g(b) * wb.head(num_cols).dot(Mk * wb.head(num_cols));
+        fpp = std::max(fpp, fpp_min);
+        p.head(num_cols) += g(b) * wb.head(num_cols);
+        d(b) = 0.;
+        dt_min = -fp / fpp;
+        t_old = t(b);
+      }
+      dt_min = std::max(dt_min, 0.);
+      t_old += dt_min;
+      for (i = 0;i < n;++i) {
+        if (d(i) != 0.) { xcp(i) = eig_x(i) + t_old * d(i); }
+      }
+      xcp = xcp.cwiseMax(eig_l).cwiseMin(eig_u);
+      c.head(num_cols) += dt_min * p.head(num_cols);
+
+      /*
+       *  Subspace minimization: the model is minimized over the variables
+       *  that are free at the Cauchy point (direct primal method),
+       *      du = -(1/\theta) r - (1/\theta^2) W_F (I - (1/\theta) M W_F^T W_F)^{-1} M W_F^T r,
+       *  with the reduced gradient r = g + \theta (xcp - x) - W M c, and the
+       *  step is truncated to stay inside the box.
+       */
+      free_vars.clear();
+      for (i = 0;i < n;++i) {
+        if (eig_l(i) < xcp(i) && xcp(i) < eig_u(i)) { free_vars.push_back(i); }
+      }
+      num_free = free_vars.size();
+      if (0 < num_free) {
+        v.head(num_cols).noalias() = Mk * c.head(num_cols);
+        for (i = 0;i < num_free;++i) {
+          j = free_vars[i];
+          du(i) = g(j) + theta * (xcp(j) - eig_x(j)) - W.row(j).head(num_cols).dot(v.head(num_cols));
+          WF.row(i).head(num_cols) = W.row(j).head(num_cols);
+        }
+        if (0 < num_cols) {
+          auto WFk = WF.topLeftCorner(num_free, num_cols);
+          Eigen::MatrixXd N = Eigen::MatrixXd::Identity(num_cols, num_cols) - Mk * (WFk.transpose() * WFk) / theta;
+          v.head(num_cols) = N.partialPivLu().solve(Mk * (WFk.transpose() * du.head(num_free)));
+          du.head(num_free) = -du.head(num_free) / theta - WFk * v.head(num_cols) / (theta * theta);
+        } else {
+          du.head(num_free) /= -theta;
+        }
+
+        alpha = 1.;
+        for (i = 0;i < num_free;++i) {
+          j = free_vars[i];
+          if (0. < du(i)) { alpha = std::min(alpha, (eig_u(j) - xcp(j)) / du(i)); }
+          else if (du(i) < 0.) { alpha = std::min(alpha, (eig_l(j) - xcp(j)) / du(i)); }
+        }
+        for (i = 0;i < num_free;++i) {
+          xcp(free_vars[i]) += alpha * du(i);
+        }
+      }
+
+      /* The search direction points to the minimizer of the model, the memory is reset if it is not a descent direction. */
+      d = xcp - eig_x;
+      if (0. <= g.dot(d)) {
+        if (0 < num_pairs) {
+          num_pairs = 0;
+          theta = 1.;
+          continue;
+        }
+        ret = LBFGSERR_INCREASEGRADIENT;
+        goto lbfgsb_exit;
+      }
+
+      /* Projected backtracking line search with the Armijo condition. */
+      xp = eig_x;
+      gp = g;
+      finit = fx;
+      step = (num_pairs == 0) ? std::min(1., 1. / d.norm()) : 1.;
+      for (ls = 1;;++ls) {
+        eig_x = (xp + step * d).cwiseMax(eig_l).cwiseMin(eig_u);
+        fx = proc_evaluate(instance, x, g.data(), n, step);
+        if (fx <= finit + param.ftol * gp.dot(eig_x - xp)) {
+          break;
+        }
+        if (param.max_linesearch <= ls || step < param.min_step) {
+          /* Revert to the previous point. */
+          eig_x = xp;
+          g = gp;
+          fx = finit;
+          ret = (param.max_linesearch <= ls) ? LBFGSERR_MAXIMUMLINESEARCH : LBFGSERR_MINIMUMSTEP;
+          goto lbfgsb_exit;
+        }
+        step *= 0.5;
+      }
+
+      /* Compute x and projected gradient norms. */
+      xnorm = eig_x.norm();
+      gnorm = ((eig_x-g).cwiseMax(eig_l).cwiseMin(eig_u)-eig_x).norm();
+
+      /* Report the progress. */
+      if (proc_progress) {
+        if ((ret = proc_progress(instance, x, g.data(), fx, xnorm, gnorm, step, n, k, ls))) {
+          goto lbfgsb_exit;
+        }
+      }
+
+      /* Convergence test on the projected gradient. */
+      if (xnorm < 1.0) xnorm = 1.0;
+      if (gnorm / xnorm <= param.epsilon) {
+        ret = LBFGS_SUCCESS;
+        break;
+      }
+
+      /* Test for stopping criterion on the rate of decrease. */
+      if (0 < param.past) {
+        if (param.past <= k) {
+          if ((pf[k % param.past] - fx) / fx < param.delta) {
+            ret = LBFGS_STOP;
+            break;
+          }
+        }
+        pf[k % param.past] = fx;
+      }
+
+      if (param.max_iterations != 0 && param.max_iterations < k+1) {
+        ret = LBFGSERR_MAXIMUMITERATION;
+        break;
+      }
+
+      /*
+       * Store the correction pair if the curvature condition holds, which the line search does not enforce.
+       * A rejected pair must not overwrite the oldest pair of a full memory.
+       */
+      s = eig_x - xp;
+      y = g - gp;
+      ys = y.dot(s);
+      yy = y.squaredNorm();
+      if (eps * yy < ys) {
+        S.col(end) = s;
+        Y.col(end) = y;
+        theta = yy / ys;
+        end = (end + 1) % m;
+        num_pairs = std::min(num_pairs + 1, m);
+      }
+      ++k;
+    }
+
+  lbfgsb_exit:
+    /* Return the final value of the objective function. */
+    if (ptr_fx != NULL) {
+      *ptr_fx = fx;
+    }
+
+    /* Store the correction pairs for the next call. */
+    if (memory != NULL) {
+      memory->s = S;
+      memory->y = Y;
+      memory->end = end;
+      memory->theta = theta;
+      memory->num_pairs = num_pairs;
+    }
+
+    return ret;
+  }
+
   static int line_search_backtracking(int n, double *x, double *f, double *g, double *s, double *stp,
     const double* xp, const double* gp, double *wp, callback_data_t *cd, const lbfgs_parameter_t *param)
   {
@@ -1018,7 +1312,8 @@ namespace solver {
   /*
    *  LBFGS Interface Class
    */
-  LbfgsSolver::LbfgsSolver() : constraints_weight_(1.), verbose_(false), initialized_(false)
+  LbfgsSolver::LbfgsSolver() : constraints_weight_(1.), verbose_(false), initialized_(false), exact_bounds_(false), augmented_lagrangian_(false),
+    num_threads_(boost::thread::hardware_concurrency()), pool_generation_(0), pool_pending_(0), pool_stop_(false)
   {
     length_of_address_to_this_ = std::ceil(double(sizeof(LbfgsSolver*))/sizeof(int));
     user_info_ = new int[length_of_address_to_this_ + 10];
@@ -1034,22 +1329,108 @@ namespace solver {
     nlproblem_->getNlpParameters(nvars_, ncons_);
     nlproblem_->optimalVector().resize(nvars_);
 
+    x_l_.resize(nvars_);  x_u_.resize(nvars_);  g_l_.resize(ncons_);  g_u_.resize(ncons_);
+    nlproblem_->getNlpBounds(nvars_, ncons_, x_l_.data(), x_u_.data(), g_l_.data(), g_u_.data());
+    workspaces_.resize(1);
+    workspaces_[0].resize(nvars_, ncons_);
+    x_shift_.setZero(nvars_);  cons_shift_.setZero(ncons_);
+    augmented_lagrangian_ = false;
+
+    // penalty gradient is assembled from analytic derivatives if the problem provides them
+    analytic_gradient_ = nlproblem_->hasObjectiveGradient() && (ncons_==0 || nlproblem_->hasConstraintsJacobian());
+    if (analytic_gradient_ && ncons_>0) {
+      int nnz = nlproblem_->getJacobianNonZeros(nvars_, ncons_);
+      jac_rows_.resize(nnz);  jac_cols_.resize(nnz);  jac_values_.resize(nnz);
+      nlproblem_->getJacobianStructure(nvars_, ncons_, jac_rows_.data(), jac_cols_.data());
+    }
+
     lbfgs_parameter_init(&opt_params_);
     //opt_params_.linesearch = LBFGS_LINESEARCH_BACKTRACKING;
     //opt_params_.max_iterations = 200;
     return (initialized_ = true);
   }
 
+  bool LbfgsSolver::initialize(NlpDescription* nlproblem, const SolverSetting& setting)
+  {
+    this->initialize(nlproblem, 0.5*setting.get(SolverDoubleParam_AugLagInitialPenalty));
+    al_max_iters_ = setting.get(SolverIntParam_AugLagMaxIters);
+    al_feasibility_tolerance_ = setting.get(SolverDoubleParam_AugLagFeasibilityTol);
+    al_optimality_tolerance_ = setting.get(SolverDoubleParam_AugLagOptimalityTol);
+    al_initial_penalty_ = setting.get(SolverDoubleParam_AugLagInitialPenalty);
+    al_penalty_growth_ = setting.get(SolverDoubleParam_AugLagPenaltyGrowth);
+    return (augmented_lagrangian_ = true);
+  }
+
   void LbfgsSolver::optimize()
   {
 	if (initialized_)
 	{
+	  // finite differences are shared among workers if the problem can be evaluated concurrently
+	  int num_workers = std::min(num_threads_, nvars_);
+	  if (!analytic_gradient_ && nlproblem_->isThreadSafe() && num_workers > 1) { this->start_workers(num_workers); }
+
+	  // variable bounds are either handled exactly by L-BFGS-B or penalized as the constraints
 	  nlproblem_->getStartingPoint(nvars_, nlproblem_->optimalVector().data());
-      opt_status_ = lbfgs(nvars_, nlproblem_->optimalVector().data(), &nlproblem_->optimalValue(),
-    		              LbfgsSolver::delegate_evaluate, LbfgsSolver::delegate_progress, user_info_, &opt_params_);
+	  if (augmented_lagrangian_) {
+        this->optimize_augmented_lagrangian();
+	  } else if (exact_bounds_) {
+        opt_status_ = lbfgsb(nvars_, nlproblem_->optimalVector().data(), &nlproblem_->optimalValue(), x_l_.data(), x_u_.data(),
+    		                 LbfgsSolver::delegate_evaluate, LbfgsSolver::delegate_progress, user_info_, &opt_params_);
+	  } else {
+        opt_status_ = lbfgs(nvars_, nlproblem_->optimalVector().data(), &nlproblem_->optimalValue(),
+    		                LbfgsSolver::delegate_evaluate, LbfgsSolver::delegate_progress, user_info_, &opt_params_);
+	  }
+      this->stop_workers();
 	}
   }
 
+  void LbfgsSolver::optimize_augmented_lagrangian()
+  {
+    // inner solves are warm started from the previous solution and correction pairs,
+    // variable bounds not handled by L-BFGS-B are shifted by their multipliers as the constraints
+    Eigen::VectorXd& x = nlproblem_->optimalVector();
+    Eigen::VectorXd x_l = Eigen::VectorXd::Constant(nvars_, -std::numeric_limits<double>::infinity());
+    Eigen::VectorXd x_u = Eigen::VectorXd::Constant(nvars_,  std::numeric_limits<double>::infinity());
+    if (exact_bounds_) { x_l = x_l_;  x_u = x_u_; }
+
+    lbfgs_parameter_t inner_params = opt_params_;
+    inner_params.epsilon = al_optimality_tolerance_;
+    Workspace& workspace = workspaces_[0];
+    double penalty_weight = al_initial_penalty_, violation, last_violation = std::numeric_limits<double>::infinity();
+    x_shift_.setZero();  cons_shift_.setZero();  al_memory_.num_pairs = 0;
+
+    for (int iter=0; iter<al_max_iters_; iter++)
+    {
+      constraints_weight_ = 0.5*penalty_weight;
+      opt_status_ = lbfgsb(nvars_, x.data(), &nlproblem_->optimalValue(), x_l.data(), x_u.data(),
+                           LbfgsSolver::delegate_evaluate, LbfgsSolver::delegate_progress, user_info_, &inner_params, &al_memory_);
+
+      // violation of the original bounds measures feasibility
+      nlproblem_->evaluateConstraintsVector(nvars_, ncons_, x.data(), workspace.cons.data());
+      penalty(workspace.cons, g_l_, g_u_, workspace.cons_violation);
+      violation = (ncons_ > 0) ? workspace.cons_violation.lpNorm<Eigen::Infinity>() : 0.;
+      if (!exact_bounds_) { penalty(x, x_l_, x_u_, workspace.x_violation);  violation = std::max(violation, workspace.x_violation.lpNorm<Eigen::Infinity>()); }
+      if (verbose_) { std::cout << "Augmented Lagrangian iteration: " << iter << ". Violation: " << violation << ". Penalty: " << penalty_weight << std::endl; }
+      if (violation <= al_feasibility_tolerance_) { break; }
+
+      // first order multiplier update, penalty grows if the violation does not decrease fast enough
+      workspace.cons += cons_shift_;
+      penalty(workspace.cons, g_l_, g_u_, workspace.cons_violation);
+      workspace.x_violation = x + x_shift_;
+      penalty(workspace.x_violation, x_l_, x_u_, workspace.x_violation);
+
+      double last_penalty_weight = penalty_weight;
+      if (violation > 0.25*last_violation) { penalty_weight *= al_penalty_growth_; }
+      last_violation = violation;
+      cons_shift_ = (last_penalty_weight/penalty_weight)*workspace.cons_violation;
+      if (!exact_bounds_) { x_shift_ = (last_penalty_weight/penalty_weight)*workspace.x_violation; }
+    }
+
+    // reported value is the objective of the problem without augmented terms
+    constraints_weight_ = 0.5*al_initial_penalty_;
+    nlproblem_->optimalValue() = nlproblem_->evaluateObjective(nvars_, x.data());
+  }
+
   double LbfgsSolver::delegate_evaluate(void *instance, const double *x, double *g, const int n, const double step )
   {
     LbfgsSolver* object_in_charge = *reinterpret_cast<LbfgsSolver** >(instance);
@@ -1058,48 +1439,135 @@ namespace solver {
 
   double LbfgsSolver::evaluate(void *instance, const double *x, double *g, const int n, const double step )
   {
-    Eigen::Map<const Eigen::VectorXd> eig_x_const(x, nvars_);
+    if (analytic_gradient_) { return evaluate_objective_and_gradient(x, g); }
+
+    if (workspaces_.size() > 1)
+    {
+      // workers start on the new point, the calling thread computes the coordinates of worker zero
+      {
+        boost::unique_lock<boost::mutex> lock(pool_mutex_);
+        pool_x_ = x;  pool_g_ = g;
+        pool_pending_ = workspaces_.size()-1;
+        pool_generation_++;
+      }
+      work_cond_.notify_all();
+      this->finite_differences(0, x, g);
+
+      boost::unique_lock<boost::mutex> lock(pool_mutex_);
+      while (pool_pending_ > 0) { done_cond_.wait(lock); }
+    }
+    else
+    {
+      this->finite_differences(0, x, g);
+    }
+
+    // computing objective
+    return evaluate_objective_function(x, workspaces_[0]);
+  }
+
+  void LbfgsSolver::finite_differences(int worker, const double* x, double* g)
+  {
+    Workspace& workspace = workspaces_[worker];
     Eigen::Map<Eigen::VectorXd> eig_jac(g, nvars_);
-    Eigen::VectorXd eig_x(nvars_);
-    eig_x = eig_x_const;
+    workspace.pert_x = Eigen::Map<const Eigen::VectorXd>(x, nvars_);
 
-    // computing jacobian
-    double prt = pow(2.,-17), gp, gm;;
-    for (int i=0; i<nvars_; i++){
-      eig_x(i) += prt;
-      gp = evaluate_objective_function(eig_x.data());
+    // computing jacobian entries of this worker
+    double prt = pow(2.,-17), gp, gm;
+    int num_workers = workspaces_.size();
+    for (int i=worker; i<nvars_; i+=num_workers){
+      workspace.pert_x(i) += prt;
+      gp = evaluate_objective_function(workspace.pert_x.data(), workspace);
 
-      eig_x(i) -= 2.*prt;
-      gm = evaluate_objective_function(eig_x.data());
+      workspace.pert_x(i) -= 2.*prt;
+      gm = evaluate_objective_function(workspace.pert_x.data(), workspace);
 
-      eig_x(i) += prt;
+      workspace.pert_x(i) = x[i];
       eig_jac(i) = (gp-gm)/(2.*prt);
     }
+  }
 
-    // computing objective
-    return evaluate_objective_function(eig_x.data());
+  void LbfgsSolver::start_workers(int num_workers)
+  {
+    workspaces_.resize(num_workers);
+    for (int worker=1; worker<num_workers; worker++) {
+      workspaces_[worker].resize(nvars_, ncons_);
+      workers_.create_thread(boost::bind(&LbfgsSolver::worker_loop, this, worker, pool_generation_));
+    }
+  }
+
+  void LbfgsSolver::stop_workers()
+  {
+    {
+      boost::unique_lock<boost::mutex> lock(pool_mutex_);
+      pool_stop_ = true;
+    }
+    work_cond_.notify_all();
+    workers_.join_all();
+
+    pool_stop_ = false;
+    workspaces_.resize(std::min<int>(workspaces_.size(), 1));
   }
 
-  double LbfgsSolver::evaluate_objective_function(const double* x)
+  void LbfgsSolver::worker_loop(int worker, int generation)
+  {
+    while (true)
+    {
+      {
+        boost::unique_lock<boost::mutex> lock(pool_mutex_);
+        while (!pool_stop_ && pool_generation_ == generation) { work_cond_.wait(lock); }
+        if (pool_stop_) { return; }
+        generation = pool_generation_;
+      }
+
+      this->finite_differences(worker, pool_x_, pool_g_);
+
+      boost::unique_lock<boost::mutex> lock(pool_mutex_);
+      if (--pool_pending_ == 0) { done_cond_.notify_one(); }
+    }
+  }
+
+  double LbfgsSolver::penalty(const Eigen::Ref<const Eigen::VectorXd>& val, const Eigen::VectorXd& lower, const Eigen::VectorXd& upper, Eigen::VectorXd& violation) const
+  {
+    // signed distance to the feasible interval, infinite bounds never contribute
+    violation = (val-lower).cwiseMin(0.) + (val-upper).cwiseMax(0.);
+    return violation.squaredNorm();
+  }
+
+  double LbfgsSolver::evaluate_objective_function(const double* x, Workspace& workspace)
   {
-	Eigen::VectorXd cons(ncons_);
     Eigen::Map<const Eigen::VectorXd> eig_x_const(&x[0], nvars_);
-    nlproblem_->evaluateConstraintsVector(nvars_, ncons_, eig_x_const.data(), cons.data());
+    nlproblem_->evaluateConstraintsVector(nvars_, ncons_, eig_x_const.data(), workspace.cons.data());
+    workspace.cons += cons_shift_;
+
+    // building objective using a penalty method for constraints, bounds are shifted by the multipliers
+    double objective = penalty(workspace.cons, g_l_, g_u_, workspace.cons_violation);
+    if (!exact_bounds_) { workspace.x_violation = eig_x_const+x_shift_;  objective += penalty(workspace.x_violation, x_l_, x_u_, workspace.x_violation); }
+    return nlproblem_->evaluateObjective(nvars_, x) + constraints_weight_*objective;
+  }
 
-    // building objective using a penalty method for constraints
-    Eigen::VectorXd eig_x_l(nvars_), eig_x_u(nvars_), eig_g_l(ncons_), eig_g_u(ncons_);
-    nlproblem_->getNlpBounds(nvars_, ncons_, eig_x_l.data(), eig_x_u.data(), eig_g_l.data(), eig_g_u.data());
+  double LbfgsSolver::evaluate_objective_and_gradient(const double* x, double* g)
+  {
+    Eigen::Map<const Eigen::VectorXd> eig_x_const(&x[0], nvars_);
+    Eigen::Map<Eigen::VectorXd> eig_jac(g, nvars_);
+    Workspace& workspace = workspaces_[0];
+    nlproblem_->evaluateObjectiveGradient(nvars_, x, g);
 
+    // penalty of violated bounds and its derivative with respect to the variables or constraints
     double objective = 0.;
-    for (int i=0; i<nvars_; i++)
+    if (!exact_bounds_)
     {
-      if (eig_x_const(i) <= eig_x_l(i)) { objective += pow(eig_x_const(i)-eig_x_l(i), 2.); }
-      if (eig_x_const(i) >= eig_x_u(i)) { objective += pow(eig_x_const(i)-eig_x_u(i), 2.); }
+      workspace.x_violation = eig_x_const+x_shift_;
+      objective += penalty(workspace.x_violation, x_l_, x_u_, workspace.x_violation);
+      eig_jac += 2.*constraints_weight_*workspace.x_violation;
     }
-    for (int i=0; i<ncons_; i++)
+    if (ncons_ > 0)
     {
-      if (cons(i) <= eig_g_l(i)) { objective += pow(cons(i)-eig_g_l(i), 2.); }
-      if (cons(i) >= eig_g_u(i)) { objective += pow(cons(i)-eig_g_u(i), 2.); }
+      nlproblem_->evaluateConstraintsVector(nvars_, ncons_, x, workspace.cons.data());
+      nlproblem_->evaluateConstraintsJacobian(nvars_, ncons_, x, jac_values_.data());
+      workspace.cons += cons_shift_;
+      objective += penalty(workspace.cons, g_l_, g_u_, workspace.cons_violation);
+      for (int k=0; k<jac_values_.size(); k++)
+        eig_jac(jac_cols_(k)) += 2.*constraints_weight_*workspace.cons_violation(jac_rows_(k))*jac_values_(k);
     }
 
     return nlproblem_->evaluateObjective(nvars_, x) + constraints_weight_*objective;
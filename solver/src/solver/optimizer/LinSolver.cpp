@@ -14,24 +14,33 @@ namespace solver {
 
   void LinSolver::resizeProblemData()
   {
+    // box constraints and lifted rows of compact second order cones are eliminated from the kkt matrix
     int psize = this->getCone().extSizeProb();
+    int ksize = psize - this->getCone().sizeBox();
+    for (int l=0; l<this->getCone().numSoc(); l++)
+      if (this->isCompactSoc(l)) { ksize -= 2; }
 
-    Pe_.resize(psize);
+    Pe_.resize(ksize, Max_Rhs);
     perm_.resize(psize);
-    permX_.resize(psize);
-    permdX_.resize(psize);
+    permB_.resize(psize, Max_Rhs);
+    permX_.setZero(psize, Max_Rhs);
+    permdX_.resize(ksize, Max_Rhs);
+    permBkkt_.resize(ksize, Max_Rhs);
     invPerm_.resize(psize);
-    kkt_.resize(psize,psize);
-    permKkt_.resize(psize,psize);
-    Gdx_.initialize(this->getCone());
+    kkt_.resize(ksize,ksize);
+    permKkt_.resize(ksize,ksize);
+    permSign_.resize(ksize);
+    kktInvPerm_.resize(ksize);
+    boxDiag_.resize(this->getCone().sizeBox());
+    xDiagIndex_.resize(this->getCone().numVars());
     sign_.initialize(this->getCone());
-    permSign_.initialize(this->getCone());
   }
 
   void LinSolver::buildProblem()
   {
     int n = this->getCone().numVars();
     int p = this->getCone().numLeq();
+    int nb = this->getCone().sizeBox();
 
     // Vector for regularization
     sign_.x().setOnes();
@@ -40,144 +49,348 @@ namespace solver {
     for (int i=0; i<this->getCone().numSoc(); i++)
       sign_.zSoc(i)[this->getCone().sizeSoc(i)+1] =  1.0;
 
-    // Building KKT matrix
-    std::vector<Eigen::Triplet<double>> coeffs;
+    // first kkt column of each second order cone
+    Eigen::VectorXi socStart(this->getCone().numSoc());
+    for (int l=0, start=n+p-nb+this->getCone().sizeLpc(); l<this->getCone().numSoc(); l++) {
+      socStart[l] = start;
+      start += this->isCompactSoc(l) ? this->getCone().sizeSoc(l) : this->getCone().sizeSoc(l)+2;
+    }
+
+    // Building KKT matrix (upper triangle), counting nonzeros per column first
     static_regularization_ = this->getSetting().get(SolverDoubleParam_StaticRegularization);
 
-    for (int id=0; id<n; id++)                 // KKT matrix (1,1)
-      coeffs.push_back(Eigen::Triplet<double>(id,id,static_regularization_));
+    // rows of A and G are the off-diagonal columns of the upper triangle, no transposes are formed
+    const Eigen::SparseMatrix<double>& A = this->getStorage().Amatrix();
+    const Eigen::SparseMatrix<double>& G = this->getStorage().Gmatrix();
+    Eigen::VectorXi next = Eigen::VectorXi::Zero(p+G.rows());
+    for (int q=0; q<A.nonZeros(); q++) { next[A.innerIndexPtr()[q]]++; }
+    for (int q=0; q<G.nonZeros(); q++) { next[p+G.innerIndexPtr()[q]]++; }
+
+    int nK = kkt_.cols();
+    int* Kp = kkt_.outerIndexPtr();
+    Kp[0] = 0;
+    int col = 0;
+    for (int id=0; id<n; id++, col++)
+      Kp[col+1] = Kp[col] + 1;
+    for (int id=0; id<p; id++, col++)
+      Kp[col+1] = Kp[col] + next[id] + 1;
+    for (int id=nb; id<this->getCone().sizeLpc(); id++, col++)
+      Kp[col+1] = Kp[col] + next[p+id] + 1;
+    for (int l=0; l<this->getCone().numSoc(); l++) {
+      int conesize = this->getCone().sizeSoc(l);
+      bool compact = this->isCompactSoc(l);
+      for (int id=0; id<conesize; id++, col++)
+        Kp[col+1] = Kp[col] + next[p+this->getCone().startSoc(l)+id] + (compact ? id+1 : 1);
+      if (compact) { continue; }
+      Kp[col+1] = Kp[col] + conesize;    col++;
+      Kp[col+1] = Kp[col] + conesize+1;  col++;
+    }
+    kkt_.resizeNonZeros(Kp[nK]);
+
+    // scattering columns of A and G into the rows they belong to keeps the row indices sorted
+    for (int id=0; id<p; id++)
+      next[id] = Kp[n+id];
+    for (int id=nb; id<this->getCone().sizeLpc(); id++)
+      next[p+id] = Kp[n+p-nb+id];
+    for (int l=0; l<this->getCone().numSoc(); l++)
+      for (int id=this->getCone().startSoc(l); id<this->getCone().startSoc(l)+this->getCone().sizeSoc(l); id++)
+        next[p+id] = Kp[socStart[l]+id-this->getCone().startSoc(l)];
+
+    int* Ki = kkt_.innerIndexPtr();
+    double* Kx = kkt_.valuePtr();
+    for (int id=0; id<n; id++) {
+      for (int q=A.outerIndexPtr()[id]; q<A.outerIndexPtr()[id+1]; q++) {
+        int k = next[A.innerIndexPtr()[q]]++;
+        Ki[k] = id;  Kx[k] = A.valuePtr()[q];
+      }
+      for (int q=G.outerIndexPtr()[id]; q<G.outerIndexPtr()[id+1]; q++) {
+        int k = next[p+G.innerIndexPtr()[q]]++;
+        Ki[k] = id;  Kx[k] = G.valuePtr()[q];
+      }
+    }
 
-    for (int id=0; id<this->getStorage().Atmatrix().outerSize(); id++) {  // KKT matrix (1,2) A'
-      for (Eigen::SparseMatrix<double>::InnerIterator it(this->getStorage().Atmatrix(),id); it; ++it)
-        coeffs.push_back(Eigen::Triplet<double>(it.row(),n+it.col(),it.value()));
-      coeffs.push_back(Eigen::Triplet<double>(n+id,n+id,-static_regularization_));
+    // diagonal entries close their columns, indices of NT scalings are positions of their entries
+    for (int id=0; id<n; id++) {                           // KKT matrix (1,1)
+      Ki[Kp[id]] = id;  Kx[Kp[id]] = static_regularization_;
     }
 
-    for (int id=0; id<this->getCone().sizeLpc(); id++) {  // KKT matrix (1,3)-(3,3) G' and -Weights
-      for (Eigen::SparseMatrix<double>::InnerIterator it(this->getStorage().Gtmatrix(),id); it; ++it)
-        coeffs.push_back(Eigen::Triplet<double>(it.row(),n+p+it.col(),it.value()));
-      coeffs.push_back(Eigen::Triplet<double>(n+p+id,n+p+id,-1.0));
-      this->getCone().indexLpc(id) = n+p+this->getStorage().Atmatrix().nonZeros()+this->getStorage().Gtmatrix().leftCols(id+1).nonZeros()+id;
+    for (int id=0; id<p; id++) {                           // KKT matrix (1,2) A'
+      int k = next[id];
+      Ki[k] = n+id;  Kx[k] = -static_regularization_;
     }
 
-    int k = n+p+this->getStorage().Atmatrix().nonZeros()+this->getStorage().Gtmatrix().leftCols(this->getCone().sizeLpc()).nonZeros()+this->getCone().sizeLpc();
+    for (int id=nb; id<this->getCone().sizeLpc(); id++) {   // KKT matrix (1,3)-(3,3) G' and -Weights
+      int k = next[p+id];
+      this->getCone().indexLpc(id) = k;
+      Ki[k] = n+p-nb+id;  Kx[k] = -1.0;
+    }
+    for (int id=0; id<nb; id++)                             // Box constraints are not part of the KKT matrix
+      this->getCone().indexLpc(id) = -1;
 
     for (int l=0; l<this->getCone().numSoc(); l++) {
-      for (int id=0; id<this->getCone().sizeSoc(l); id++) {
-        for (Eigen::SparseMatrix<double>::InnerIterator it(this->getStorage().Gtmatrix(),this->getCone().startSoc(l)+id); it; ++it)
-          coeffs.push_back(Eigen::Triplet<double>(it.row(),n+p+2*l+it.col(),it.value()));
-        coeffs.push_back(Eigen::Triplet<double>(n+p+this->getCone().startSoc(l)+2*l+id,n+p+this->getCone().startSoc(l)+2*l+id,-1.0));
-        this->getCone().soc(l).indexSoc(id) = k+this->getStorage().Gtmatrix().col(this->getCone().startSoc(l)+id).nonZeros();
+      int conesize = this->getCone().sizeSoc(l);
+      int start = socStart[l];
+      if (this->isCompactSoc(l)) {
+        // dense upper triangle of the scaling, column id holds rows 0..id of the cone
+        for (int id=0; id<conesize; id++) {
+          int k = next[p+this->getCone().startSoc(l)+id];
+          for (int i=0; i<=id; i++, k++) {
+            this->getCone().soc(l).indexSoc(id*(id+1)/2+i) = k;
+            Ki[k] = start+i;  Kx[k] = (i==id ? -1.0 : 0.0);
+          }
+        }
+        continue;
+      }
 
-        k += this->getStorage().Gtmatrix().col(this->getCone().startSoc(l)+id).nonZeros()+1;
+      for (int id=0; id<conesize; id++) {
+        int k = next[p+this->getCone().startSoc(l)+id];
+        this->getCone().soc(l).indexSoc(id) = k;
+        Ki[k] = start+id;  Kx[k] = -1.0;
       }
-      k += 2*this->getCone().sizeSoc(l)+1;
 
-      for (int id=1; id<this->getCone().sizeSoc(l); id++)
-        coeffs.push_back(Eigen::Triplet<double>(n+p+this->getCone().startSoc(l) + 2*l + id,n+p+this->getCone().startSoc(l)+2*l+this->getCone().sizeSoc(l), 0.0));
-      coeffs.push_back(Eigen::Triplet<double>(n+p+this->getCone().startSoc(l)+2*l+this->getCone().sizeSoc(l),n+p+this->getCone().startSoc(l)+2*l+this->getCone().sizeSoc(l),-1.0));
+      int k = Kp[start+conesize];
 
-      for (int id=0; id<this->getCone().sizeSoc(l); id++)
-        coeffs.push_back(Eigen::Triplet<double>(n+p+this->getCone().startSoc(l)+2*l+id,n+p+this->getCone().startSoc(l)+2*l+this->getCone().sizeSoc(l)+1,0.0));
-      coeffs.push_back(Eigen::Triplet<double>(n+p+this->getCone().startSoc(l)+2*l+this->getCone().sizeSoc(l)+1,n+p+this->getCone().startSoc(l)+2*l+this->getCone().sizeSoc(l)+1,1.0));
-    }
+      for (int id=1; id<conesize; id++) {
+        this->getCone().soc(l).indexSoc(conesize+id-1) = k;
+        Ki[k] = start+id;  Kx[k++] = 0.0;
+      }
+      this->getCone().soc(l).indexSoc(2*conesize-1) = k;
+      Ki[k] = start+conesize;  Kx[k++] = -1.0;
 
-    kkt_.setFromTriplets(coeffs.begin(), coeffs.end());
-    if (!kkt_.isCompressed()) { kkt_.makeCompressed(); }
+      for (int id=0; id<conesize; id++) {
+        this->getCone().soc(l).indexSoc(2*conesize+id) = k;
+        Ki[k] = start+id;  Kx[k++] = 0.0;
+      }
+      this->getCone().soc(l).indexSoc(3*conesize) = k;
+      Ki[k] = start+conesize+1;  Kx[k++] = 1.0;
+    }
   }
 
-  void LinSolver::findPermutation()
+  void LinSolver::findPermutation(bool use_cache)
   {
-    // find permutation and inverse permutation
-    Eigen::AMDOrdering<int> ordering;
-    ordering(kkt_, perm_);
+    // find permutation of kkt matrix, reusing a cached one if available
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic> kktPerm;
+    int ordering_type = this->getSetting().get(SolverIntParam_KktOrdering);
+    const std::string& cache_dir = this->getSetting().get(SolverStringParam_OrderingCacheDir);
+    is_dense_ = kkt_.cols() <= this->getSetting().get(SolverIntParam_DenseKktThreshold);
+    is_cached_ordering_ = !is_dense_ && use_cache && !cache_dir.empty() && ordering_cache_.load(cache_dir, kkt_, ordering_type);
+    if (is_dense_) {
+      // small matrices skip the ordering, without pivoting cone rows are eliminated before the weakly regularized primal and equality blocks
+      int n = this->getCone().numVars(), p = this->getCone().numLeq(), nK = kkt_.cols();
+      kktPerm.resize(nK);
+      for (int i=0; i<nK-n-p; i++) { kktPerm.indices()[i] = n+p+i; }
+      for (int i=0; i<n+p; i++) { kktPerm.indices()[nK-n-p+i] = i; }
+    } else if (is_cached_ordering_) {
+      kktPerm.indices() = ordering_cache_.perm();
+    } else if (ordering_type == static_cast<int>(KktOrdering::NestedDissection)) {
+      linalg::NestedDissectionOrdering ordering;
+      ordering(kkt_, kktPerm);
+    } else {
+      Eigen::AMDOrdering<int> ordering;
+      ordering(kkt_, kktPerm);
+    }
+    kktInvPerm_ = kktPerm.inverse();
+
+    // extend it to the full problem, box constraints and then lifted rows of compact cones are appended at the end
+    int nK = kkt_.cols();
+    int lpstart = this->getCone().lpConeStart();
+    int nb = this->getCone().sizeBox();
+    Eigen::VectorXi extId(nK);
+    int col = 0, excluded = nK+nb;
+    for (int id=0; id<this->getCone().soConeStart()-nb; id++) { extId[col++] = id<lpstart ? id : id+nb; }
+    for (int l=0; l<this->getCone().numSoc(); l++) {
+      int start = this->getCone().extStartSoc(l), conesize = this->getCone().sizeSoc(l);
+      int nrows = this->isCompactSoc(l) ? conesize : conesize+2;
+      for (int i=0; i<nrows; i++) { extId[col++] = start+i; }
+      for (int i=nrows; i<conesize+2; i++) { perm_.indices()[excluded++] = start+i; }
+    }
+    for (int i=0; i<nK; i++) { perm_.indices()[i] = extId[kktPerm.indices()[i]]; }
+    for (int i=0; i<nb; i++) { perm_.indices()[nK+i] = lpstart+i; }
     invPerm_ = perm_.inverse();
 
     // permute quantities
-    for (int i=0; i<this->getCone().extSizeProb(); i++) { permSign_[i] = sign_[perm_.indices()[i]]; }
-    permKkt_.selfadjointView<Eigen::Upper>() = kkt_.selfadjointView<Eigen::Upper>().twistedBy(invPerm_);
+    for (int i=0; i<nK; i++) { permSign_[i] = sign_[perm_.indices()[i]]; }
+    permuteMatrix();
+  }
+
+  void LinSolver::permuteMatrix()
+  {
+    // entry (i,j) of the upper triangle is moved to column max(P(i),P(j)) of the permuted matrix
+    int nK = kkt_.cols();
+    const int* Kp = kkt_.outerIndexPtr();
+    const int* Ki = kkt_.innerIndexPtr();
+    const double* Kx = kkt_.valuePtr();
+    const int* kktInvPerm = kktInvPerm_.indices().data();
+
+    int* Pp = permKkt_.outerIndexPtr();
+    Eigen::VectorXi next = Eigen::VectorXi::Zero(nK);
+    for (int j=0; j<nK; j++)
+      for (int q=Kp[j]; q<Kp[j+1]; q++)
+        next[std::max(kktInvPerm[Ki[q]], kktInvPerm[j])]++;
+
+    Pp[0] = 0;
+    for (int j=0; j<nK; j++) { Pp[j+1] = Pp[j] + next[j];  next[j] = Pp[j]; }
+    permKkt_.resizeNonZeros(Pp[nK]);
+
+    int* Pi = permKkt_.innerIndexPtr();
+    double* Px = permKkt_.valuePtr();
+    permK_.resize(Kp[nK]);
+    for (int j=0; j<nK; j++)
+      for (int q=Kp[j]; q<Kp[j+1]; q++) {
+        int row = kktInvPerm[Ki[q]], col = kktInvPerm[j];
+        int pos = next[std::max(row,col)]++;
+        Pi[pos] = std::min(row,col);
+        Px[pos] = Kx[q];
+        permK_[q] = pos;
+      }
   }
 
   void LinSolver::symbolicFactorization()
   {
-    this->getCholesky().analyzePattern(permKkt_, this->getSetting());
+    const std::string& cache_dir = this->getSetting().get(SolverStringParam_OrderingCacheDir);
+    if (is_dense_) {
+      dense_cholesky_.analyzePattern(permKkt_, this->getSetting());
+    } else if (is_cached_ordering_) {
+      // an entry whose elimination tree differs from the recomputed one belongs to another pattern, it is replaced
+      this->getCholesky().analyzePattern(permKkt_, this->getSetting());
+      if (this->getCholesky().parent()!=ordering_cache_.parent() || this->getCholesky().lnnz()!=ordering_cache_.lnnz()) {
+        this->findPermutation(false);
+        this->symbolicFactorization();
+      }
+    } else {
+      this->getCholesky().analyzePattern(permKkt_, this->getSetting());
+      if (!cache_dir.empty()) {
+        Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic> kktPerm = kktInvPerm_.inverse();
+        ordering_cache_.save(cache_dir, kkt_, this->getSetting().get(SolverIntParam_KktOrdering), kktPerm.indices(), this->getCholesky().parent(), this->getCholesky().lnnz());
+      }
+    }
   }
 
   FactStatus LinSolver::numericFactorization()
   {
-    int status = this->getCholesky().factorize(this->permKkt_, this->permSign_);
+    int status = is_dense_ ? dense_cholesky_.factorize(this->permKkt_, this->permSign_)
+                           : this->getCholesky().factorize(this->permKkt_, this->permSign_);
     return (status == this->permKkt_.cols() ? FactStatus::Optimal : FactStatus::Failure);
   }
 
-  int LinSolver::solve(const Eigen::Ref<const Eigen::VectorXd>& permB, OptimizationVector& searchDir, bool is_initialization)
+  int LinSolver::solve(const Eigen::Ref<const Eigen::VectorXd>& permB, OptimizationVector& searchDir)
   {
     int numRefs;
-    int nK = this->getCone().extSizeProb();
-    int mext = this->getCone().extSizeCone();
+    OptimizationVector* searchDirs[] = {&searchDir};
+    this->solveBlock(permB, searchDirs, &numRefs);
+    return numRefs;
+  }
 
-    double* Gdx = Gdx_.data();
-    Eigen::VectorXd permdZ(mext);
-    int* Pinv = this->invPerm_.indices().data();
-    ExtendedVector err; err.initialize(this->getCone());
-    double errNorm_cur, errNorm_prev = SolverSetting::nan;
-    double errThresh = (1.0 + (nK>0 ? permB.lpNorm<Eigen::Infinity>() : 0.0 ))*this->getSetting().get(SolverDoubleParam_LinearSystemAccuracy);
+  void LinSolver::solve(const Eigen::Ref<const Eigen::VectorXd>& permB1, OptimizationVector& searchDir1, int& numRefs1,
+                        const Eigen::Ref<const Eigen::VectorXd>& permB2, OptimizationVector& searchDir2, int& numRefs2)
+  {
+    int numRefs[Max_Rhs];
+    OptimizationVector* searchDirs[] = {&searchDir1, &searchDir2};
+    permB_.col(0) = permB1;
+    permB_.col(1) = permB2;
+    this->solveBlock(permB_, searchDirs, numRefs);
+    numRefs1 = numRefs[0];
+    numRefs2 = numRefs[1];
+  }
 
-    double* ez = err.z().data();
-    double* dz = searchDir.z().data();
+  void LinSolver::solveBlock(const Eigen::Ref<const Eigen::MatrixXd>& permB, OptimizationVector** searchDirs, int* numRefs)
+  {
+    int nrhs = permB.cols(), nactive = nrhs;
+    int nK = kkt_.cols();
+    int maxRefs = this->getSetting().get(SolverIntParam_NumIterRefinementsLinSolve);
+    int active[Max_Rhs];
+    double errNorm_cur, errNorm_prev[Max_Rhs], errThresh[Max_Rhs];
+
+    for (int k=0; k<nrhs; k++) {
+      active[k] = k;
+      errNorm_prev[k] = SolverSetting::nan;
+      errThresh[k] = (1.0 + (permB.rows()>0 ? permB.col(k).lpNorm<Eigen::Infinity>() : 0.0 ))*this->getSetting().get(SolverDoubleParam_LinearSystemAccuracy);
+    }
 
-    // solve perturbed linear system
-    this->getCholesky().solve(permB, permX_.data());
+    // solve perturbed linear systems, the solution stays in kkt ordering until refinement is done
+    this->condenseBoxRows(permB, permBkkt_.leftCols(nrhs));
+    permX_.topRows(nK).leftCols(nrhs) = permBkkt_.leftCols(nrhs);
+    this->solveKkt(permX_.topRows(nK).leftCols(nrhs));
 
-    // iterative refinement due to regularization to KKT matrix factorization
-    for (numRefs=0; numRefs <= this->getSetting().get(SolverIntParam_NumIterRefinementsLinSolve); numRefs++)
+    // iterative refinement due to regularization to KKT matrix factorization, right hand
+    // sides that still need a correction share the solve, column a of permdX holds the
+    // last correction of active[a]
+    for (int ref=0; nactive>0; ref++)
     {
-      this->getCone().unpermuteSolution(invPerm_, permX_, searchDir, permdZ);
-      for (int i=0; i<nK; i++) { err[i] = permB[Pinv[i]]; }
-
-      // error_x = b_x - (Is dx + A' dy + G' dz)
-      matrixTransposeTimesVector(this->getStorage().Amatrix(), searchDir.y(), err.x(), false, false);
-      matrixTransposeTimesVector(this->getStorage().Gmatrix(), searchDir.z(), err.x(), false, false);
-      err.x() -= static_regularization_*searchDir.x();
-
-      // error_y = b_y - (A dx - Is dy)
-      if (this->getStorage().Amatrix().nonZeros()>0) {
-        matrixTransposeTimesVector(this->getStorage().Atmatrix(), searchDir.x(), err.y(), false, false);
-        err.y() += static_regularization_*searchDir.y();
+      int nrefine = 0;
+      for (int a=0; a<nactive; a++)
+      {
+        int k = active[a];
+        errNorm_cur = this->kktResidual(permBkkt_.col(k), permX_.col(k).head(nK), Pe_.col(nrefine));
+
+        // progress checks
+        if (ref>0 && errNorm_cur>errNorm_prev[k]) { permX_.col(k).head(nK) -= permdX_.col(a); numRefs[k] = ref-1; continue; }
+        if (ref>=maxRefs || (errNorm_cur<errThresh[k]) || (ref>0 && errNorm_prev[k]<this->getSetting().get(SolverDoubleParam_ErrorReductionFactor)*errNorm_cur)) { numRefs[k] = ref; continue; }
+        errNorm_prev[k] = errNorm_cur;
+        active[nrefine++] = k;
       }
+      nactive = nrefine;
+      if (nactive==0) { break; }
 
-      // error_z = b_z - (G dx +(Is+W2) dz)
-      matrixTransposeTimesVector(this->getStorage().Gtmatrix(), searchDir.x(), Gdx_, true, true);
-      err.zLpc() += -Gdx_.zLpc() + static_regularization_*searchDir.zLpc();
-      for (int i=0; i<this->getCone().numSoc(); i++) {
-        for (int j=0; j<this->getCone().sizeSoc(i)-1; j++)
-          ez[this->getCone().startSoc(i)+2*i+j] += -Gdx[this->getCone().startSoc(i)+j] + static_regularization_*dz[this->getCone().startSoc(i)+j];
-        ez[this->getCone().startSoc(i)+2*i+this->getCone().sizeSoc(i)-1] -= Gdx[this->getCone().startSoc(i)+this->getCone().sizeSoc(i)-1] + static_regularization_*dz[this->getCone().startSoc(i)+this->getCone().sizeSoc(i)-1];
+      // solve and add refinements to permX
+      permdX_.leftCols(nactive) = Pe_.leftCols(nactive);
+      this->solveKkt(permdX_.leftCols(nactive));
+      for (int a=0; a<nactive; a++) { permX_.col(active[a]).head(nK) += permdX_.col(a); }
+    }
+
+    // recover multipliers of box constraints and store solutions within search directions
+    this->recoverBoxRows(permB, permX_.leftCols(nrhs));
+    for (int k=0; k<nrhs; k++)
+      this->getCone().unpermuteSolution(invPerm_, permX_.col(k), *searchDirs[k]);
+  }
+
+  double LinSolver::kktResidual(const Eigen::Ref<const Eigen::VectorXd>& permB, const Eigen::Ref<const Eigen::VectorXd>& permX, Eigen::Ref<Eigen::VectorXd> permE)
+  {
+    // error = b - K x in kkt ordering, with K symmetric and stored by its upper triangle
+    const double* x = permX.data();
+    double* e = permE.data();
+    const double* Kx = permKkt_.valuePtr();
+    const int* Kp = permKkt_.outerIndexPtr();
+    const int* Ki = permKkt_.innerIndexPtr();
+
+    permE = permB;
+    for (int j=0; j<permKkt_.cols(); j++) {
+      double xj = x[j], ej = 0.0;
+      for (int p=Kp[j]; p<Kp[j+1]; p++) {
+        if (Ki[p]==j) { ej += Kx[p]*xj; }
+        else { e[Ki[p]] -= Kx[p]*xj;  ej += Kx[p]*x[Ki[p]]; }
       }
-      if (is_initialization) { err.z() += permdZ; }
-      else { this->getCone().conicNTScaling2(permdZ, err.z()); }
-
-      // progress checks
-      errNorm_cur = err.size()>0 ? err.lpNorm<Eigen::Infinity>() : 0.0;
-      if (numRefs>0 && errNorm_cur>errNorm_prev ) { permX_ -= permdX_; numRefs--; break; }
-      if (numRefs==this->getSetting().get(SolverIntParam_NumIterRefinementsLinSolve) || (errNorm_cur<errThresh) || (numRefs>0 && errNorm_prev<this->getSetting().get(SolverDoubleParam_ErrorReductionFactor)*errNorm_cur)) { break; }
-      errNorm_prev = errNorm_cur;
-
-      // solve and add refinement to permX
-      for (int i=0; i<nK; i++) { Pe_[Pinv[i]] = err[i]; }
-      this->getCholesky().solve(Pe_, permdX_.data());
-      permX_ += permdX_;
+      e[j] -= ej;
     }
 
-    // store solution within search direction
-    this->getCone().unpermuteSolution(invPerm_, permX_, searchDir);
-    return numRefs;
+    // the error is measured as in the unreduced formulation, which differs from K on the
+    // diagonal of the last entry and of the lifted variable u of each second order cone,
+    // compact cones are that formulation with u and v eliminated
+    const int* Pinv = invPerm_.indices().data();
+    for (int l=0; l<this->getCone().numSoc(); l++) {
+      int last = Pinv[this->getCone().extStartSoc(l)+this->getCone().sizeSoc(l)-1];
+      if (this->isCompactSoc(l)) {
+        if (!is_initial_matrix_) { e[last] -= 2.0*static_regularization_*x[last]; }
+        continue;
+      }
+      int u = Pinv[this->getCone().extStartSoc(l)+this->getCone().sizeSoc(l)+1];
+      if (is_initial_matrix_) { e[u] += 2.0*x[u]; }
+      else { e[last] -= 2.0*static_regularization_*x[last];  e[u] += static_regularization_*x[u]; }
+    }
+
+    return permE.size()>0 ? permE.lpNorm<Eigen::Infinity>() : 0.0;
   }
 
-  void LinSolver::initialize(Cone& cone, SolverSetting& setting, SolverStorage& storage)
+  void LinSolver::initialize(Cone& cone, const SolverSetting& setting, SolverStorage& storage)
+  {
+    this->initialize(cone, std::make_shared<const SolverSetting>(setting), storage);
+  }
+
+  void LinSolver::initialize(Cone& cone, const std::shared_ptr<const SolverSetting>& setting, SolverStorage& storage)
   {
     cone_ = &cone;
     storage_ = &storage;
-    setting_ = &setting;
+    setting_ = setting;
 
     resizeProblemData();
     buildProblem();
@@ -185,39 +398,40 @@ namespace solver {
     symbolicFactorization();
 
     // update indices of NT scalings to access them directly in permuted matrix
-    Eigen::VectorXi index = Eigen::Map<Eigen::VectorXi>(permKkt_.outerIndexPtr(), this->getCone().extSizeProb()+1);
-    permK_.resize(kkt_.nonZeros());
-    int nnz = 0;
-    for (int j=0; j<kkt_.outerSize(); j++)
-      for (Eigen::SparseMatrix<double>::InnerIterator it(kkt_,j); it; ++it)
-        if (it.row()<=it.col()) {
-          permK_.indices()[nnz] = index[invPerm_.indices()[it.row()] > invPerm_.indices()[it.col()] ?
-                                        invPerm_.indices()[it.row()] : invPerm_.indices()[it.col()]]++;
-          nnz += 1;
-        }
+    for (int id=this->getCone().sizeBox(); id<this->getCone().sizeLpc(); id++)
+      this->getCone().indexLpc(id) = permK_[this->getCone().indexLpc(id)];
 
-    for (int id=0; id<this->getCone().sizeLpc(); id++)
-      this->getCone().indexLpc(id) = permK_.indices()[this->getCone().indexLpc(id)];
+    // columns of primal variables only hold their diagonal entry
+    for (int j=0; j<this->getCone().numVars(); j++)
+      xDiagIndex_[j] = permK_[j];
 
-    for (int i=0; i<this->getCone().numSoc(); i++) {
-      int j=1;
-      for (int k=0; k<2*this->getCone().sizeSoc(i)+1; k++)
-        this->getCone().soc(i).indexSoc(this->getCone().sizeSoc(i)+k) = permK_.indices()[this->getCone().soc(i).indexSoc(this->getCone().sizeSoc(i)-1)+j++];
-      for (int k=0; k<this->getCone().sizeSoc(i); k++)
-        this->getCone().soc(i).indexSoc(k) = permK_.indices()[this->getCone().soc(i).indexSoc(k)];
-    }
+    for (int i=0; i<this->getCone().numSoc(); i++)
+      for (int k=0; k<this->numSocIndices(i); k++)
+        this->getCone().soc(i).indexSoc(k) = permK_[this->getCone().soc(i).indexSoc(k)];
   }
 
   void LinSolver::initializeMatrix()
   {
+    is_initial_matrix_ = true;
     double* value = permKkt_.valuePtr();
 
     // Linear cone
-    for (int i=0; i<this->getCone().sizeLpc(); i++)
+    for (int i=this->getCone().sizeBox(); i<this->getCone().sizeLpc(); i++)
       value[this->getCone().indexLpc(i)] = -1.0;
 
+    // Box constraints
+    boxDiag_.setOnes();
+    updateBoxScalings();
+
     // Second order cone
     for (int i=0; i<this->getCone().numSoc(); i++) {
+      if (this->isCompactSoc(i)) {
+        for (int j=0; j<this->getCone().sizeSoc(i); j++)
+          for (int k=0; k<=j; k++)
+            value[this->getCone().soc(i).indexSoc(j*(j+1)/2+k)] = (k==j ? -1.0 : 0.0);
+        continue;
+      }
+
       value[this->getCone().soc(i).indexSoc(0)] = -1.0;
       for (int k=1; k<this->getCone().sizeSoc(i); k++)
         value[this->getCone().soc(i).indexSoc(k)] = -1.0;
@@ -235,21 +449,41 @@ namespace solver {
 
   void LinSolver::updateMatrix()
   {
+    is_initial_matrix_ = false;
     static_regularization_ = this->getSetting().get(SolverDoubleParam_StaticRegularization);
     int conesize;
     double eta_square, *scaling_soc;
     double* value = permKkt_.valuePtr();
 
     // Linear cone
-    for (int i=0; i<this->getCone().sizeLpc(); i++)
+    for (int i=this->getCone().sizeBox(); i<this->getCone().sizeLpc(); i++)
       value[this->getCone().indexLpc(i)] = -this->getCone().sqScalingLpc(i) - static_regularization_;
 
+    // Box constraints
+    for (int i=0; i<this->getCone().sizeBox(); i++)
+      boxDiag_[i] = this->getCone().sqScalingLpc(i) + static_regularization_;
+    updateBoxScalings();
+
     // Second order cone
     for (int i=0; i<this->getCone().numSoc(); i++) {
       conesize = this->getCone().sizeSoc(i);
       eta_square = this->getCone().soc(i).etaSquare();
       scaling_soc = this->getCone().soc(i).scalingSoc().data();
 
+      if (this->isCompactSoc(i)) {
+        // -W^2 = -eta^2 (D + u u' - v v'), with D = diag(d1,1,..,1), u = [u0; u1 wbar1] and v = [0; v1 wbar1]
+        const NesterovToddScaling& nt = this->getCone().soc(i);
+        double uv = nt.u1()*nt.u1() - nt.v1()*nt.v1();
+        value[nt.indexSoc(0)] = -eta_square * (nt.d1() + nt.u0()*nt.u0()) - static_regularization_;
+        for (int j=1; j<conesize; j++) {
+          value[nt.indexSoc(j*(j+1)/2)] = -eta_square * nt.u0() * nt.u1() * scaling_soc[j];
+          for (int k=1; k<j; k++)
+            value[nt.indexSoc(j*(j+1)/2+k)] = -eta_square * uv * scaling_soc[k] * scaling_soc[j];
+          value[nt.indexSoc(j*(j+1)/2+j)] = -eta_square * (1.0 + uv * scaling_soc[j] * scaling_soc[j]) - static_regularization_;
+        }
+        continue;
+      }
+
       value[this->getCone().soc(i).indexSoc(0)] = -eta_square * this->getCone().soc(i).d1() - static_regularization_;
       for (int k=1; k<conesize; k++)
         value[this->getCone().soc(i).indexSoc(k)] = -eta_square - static_regularization_;
@@ -265,6 +499,100 @@ namespace solver {
     }
   }
 
+  void LinSolver::updateBoxScalings()
+  {
+    if (this->getCone().sizeBox()==0) { return; }
+
+    // eliminated box rows contribute B'*inv(W2)*B to the (1,1) block
+    double* value = permKkt_.valuePtr();
+    const int* idx = this->getStorage().boxIndex().data();
+    const double* coeff = this->getStorage().boxCoeff().data();
+
+    for (int j=0; j<this->getCone().numVars(); j++)
+      value[xDiagIndex_[j]] = static_regularization_;
+    for (int i=0; i<this->getCone().sizeBox(); i++)
+      value[xDiagIndex_[idx[i]]] += coeff[i]*coeff[i]/boxDiag_[i];
+  }
+
+  void LinSolver::condenseBoxRows(const Eigen::Ref<const Eigen::MatrixXd>& permB, Eigen::Ref<Eigen::MatrixXd> permBkkt)
+  {
+    int nK = kkt_.cols();
+    int nb = this->getCone().sizeBox();
+    const int* Pinv = invPerm_.indices().data();
+    const int* idx = this->getStorage().boxIndex().data();
+    const double* coeff = this->getStorage().boxCoeff().data();
+
+    // condense box rows into right hand side of the primal variables
+    permBkkt = permB.topRows(nK);
+    for (int k=0; k<permB.cols(); k++)
+      for (int i=0; i<nb; i++)
+        permBkkt(Pinv[idx[i]],k) += coeff[i]*permB(nK+i,k)/boxDiag_[i];
+  }
+
+  void LinSolver::recoverBoxRows(const Eigen::Ref<const Eigen::MatrixXd>& permB, Eigen::Ref<Eigen::MatrixXd> permX)
+  {
+    int nK = kkt_.cols();
+    int nb = this->getCone().sizeBox();
+    const int* Pinv = invPerm_.indices().data();
+    const int* idx = this->getStorage().boxIndex().data();
+    const double* coeff = this->getStorage().boxCoeff().data();
+
+    // recover multipliers of box constraints
+    for (int k=0; k<permB.cols(); k++)
+      for (int i=0; i<nb; i++)
+        permX(nK+i,k) = (coeff[i]*permX(Pinv[idx[i]],k) - permB(nK+i,k))/boxDiag_[i];
+  }
+
+  void LinSolver::solveKkt(Eigen::Ref<Eigen::MatrixXd> permX)
+  {
+    if (is_dense_) { dense_cholesky_.solve(permX); }
+    else { this->getCholesky().solve(permX); }
+  }
+
+  void LinSolver::boxTimesVector(const Eigen::Ref<const Eigen::VectorXd>& eig_x,
+                                 Eigen::Ref<Eigen::VectorXd> eig_y, bool add)
+  {
+    const int* idx = this->getStorage().boxIndex().data();
+    const double* coeff = this->getStorage().boxCoeff().data();
+    double sgn = add ? 1.0 : -1.0;
+
+    for (int i=0; i<this->getCone().sizeBox(); i++)
+      eig_y[i] += sgn*coeff[i]*eig_x[idx[i]];
+  }
+
+  void LinSolver::boxTransposeTimesVector(const Eigen::Ref<const Eigen::VectorXd>& eig_z,
+                                          Eigen::Ref<Eigen::VectorXd> eig_y, bool add)
+  {
+    const int* idx = this->getStorage().boxIndex().data();
+    const double* coeff = this->getStorage().boxCoeff().data();
+    double sgn = add ? 1.0 : -1.0;
+
+    for (int i=0; i<this->getCone().sizeBox(); i++)
+      eig_y[idx[i]] += sgn*coeff[i]*eig_z[i];
+  }
+
+  void LinSolver::matrixTimesVector(const Eigen::SparseMatrix<double>& A,
+                                    const Eigen::Ref<const Eigen::VectorXd>& eig_x,
+                                    Eigen::Ref<Eigen::VectorXd> eig_y,
+                                    bool add, bool is_new)
+  {
+    // column oriented product, scatters each column of A scaled by its entry of x
+    double xlocal;
+    if (is_new) { eig_y.setZero(); }
+
+    double* y = eig_y.data();
+    const double* x = eig_x.data();
+    const double* valPtr = A.valuePtr();
+    const int* outPtr = A.outerIndexPtr();
+    const int* innPtr = A.innerIndexPtr();
+
+    for (int col=0; col<A.cols(); col++) {
+      xlocal = add ? x[col] : -x[col];
+      for (int row=outPtr[col]; row<outPtr[col+1]; row++)
+        y[innPtr[row]] += valPtr[row]*xlocal;
+    }
+  }
+
   void LinSolver::matrixTransposeTimesVector(const Eigen::SparseMatrix<double>& A,
                                              const Eigen::Ref<const Eigen::VectorXd>& eig_x,
                                              Eigen::Ref<Eigen::VectorXd> eig_y,
@@ -0,0 +1,193 @@
+/**
+ * @file NestedDissection.cpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <Eigen/OrderingMethods>
+#include <solver/optimizer/NestedDissection.hpp>
+
+namespace linalg {
+
+  void NestedDissectionOrdering::operator()(const Eigen::SparseMatrix<double>& mat, PermutationType& perm)
+  {
+    int n = mat.cols();
+    this->buildGraph(mat);
+
+    num_labels_ = 0;
+    label_.assign(n, -1);
+    level_.assign(n, -1);
+    local_.assign(n, -1);
+    order_.clear();
+    order_.reserve(n);
+
+    // dense nodes would collapse the level structures, they are ordered last
+    std::vector<int> nodes, dense;
+    int dense_degree = std::max(16, int(10.0*std::sqrt(double(n))));
+    for (int i=0; i<n; i++) {
+      if (xadj_[i+1]-xadj_[i] > dense_degree) { dense.push_back(i); }
+      else { nodes.push_back(i); }
+    }
+    this->dissect(nodes);
+    order_.insert(order_.end(), dense.begin(), dense.end());
+
+    perm.resize(n);
+    for (int i=0; i<n; i++) { perm.indices()[i] = order_[i]; }
+  }
+
+  void NestedDissectionOrdering::buildGraph(const Eigen::SparseMatrix<double>& mat)
+  {
+    // adjacency structure of the symmetric pattern, diagonal excluded
+    int n = mat.cols();
+    xadj_.assign(n+1, 0);
+    for (int col=0; col<mat.outerSize(); col++)
+      for (Eigen::SparseMatrix<double>::InnerIterator it(mat,col); it; ++it)
+        if (it.row()!=it.col()) { xadj_[it.row()+1]++; xadj_[it.col()+1]++; }
+    for (int i=0; i<n; i++) { xadj_[i+1] += xadj_[i]; }
+
+    std::vector<int> next(xadj_.begin(), xadj_.end()-1);
+    adj_.resize(xadj_[n]);
+    for (int col=0; col<mat.outerSize(); col++)
+      for (Eigen::SparseMatrix<double>::InnerIterator it(mat,col); it; ++it)
+        if (it.row()!=it.col()) { adj_[next[it.row()]++] = it.col(); adj_[next[it.col()]++] = it.row(); }
+  }
+
+  int NestedDissectionOrdering::levelStructure(int root, int label, std::vector<int>& visited)
+  {
+    // breadth first search restricted to the subgraph with the given label
+    visited.clear();
+    visited.push_back(root);
+    label_[root] = label+1;
+    level_[root] = 0;
+
+    for (size_t head=0; head<visited.size(); head++) {
+      int v = visited[head];
+      for (int k=xadj_[v]; k<xadj_[v+1]; k++) {
+        int w = adj_[k];
+        if (label_[w]==label) {
+          label_[w] = label+1;
+          level_[w] = level_[v]+1;
+          visited.push_back(w);
+        }
+      }
+    }
+
+    for (size_t i=0; i<visited.size(); i++) { label_[visited[i]] = label; }
+    return level_[visited.back()]+1;
+  }
+
+  void NestedDissectionOrdering::dissect(const std::vector<int>& nodes)
+  {
+    if (nodes.size()==0) { return; }
+    if ((int)nodes.size()<=leaf_size_) { this->orderLeaf(nodes); return; }
+
+    // labels are even, odd values mark nodes visited by the current search
+    int label = 2*(num_labels_++);
+    for (size_t i=0; i<nodes.size(); i++) { label_[nodes[i]] = label; }
+
+    // components are found in one sweep over the nodes and dissected in turn, isolated nodes are ordered directly
+    std::vector<int> component;
+    for (size_t i=0; i<nodes.size(); i++) {
+      int v = nodes[i];
+      if (label_[v]!=label) { continue; }
+      this->levelStructure(v, label, component);
+      for (size_t j=0; j<component.size(); j++) { label_[component[j]] = -1; }
+
+      if (component.size()==1) { order_.push_back(v); }
+      else if ((int)component.size()<=leaf_size_) { this->orderLeaf(component); }
+      else { this->dissectComponent(component); }
+    }
+  }
+
+  void NestedDissectionOrdering::dissectComponent(const std::vector<int>& nodes)
+  {
+    int label = 2*(num_labels_++);
+    for (size_t i=0; i<nodes.size(); i++) { label_[nodes[i]] = label; }
+
+    // pseudo-peripheral root: restart from a minimum degree node of the last level
+    std::vector<int> visited, candidate;
+    int root = nodes[0];
+    int num_levels = this->levelStructure(root, label, visited);
+    for (int iter=0; iter<8; iter++) {
+      int last_level = num_levels-1, best = -1;
+      for (int i=(int)visited.size()-1; i>=0 && level_[visited[i]]==last_level; i--)
+        if (best<0 || xadj_[visited[i]+1]-xadj_[visited[i]] < xadj_[best+1]-xadj_[best]) { best = visited[i]; }
+      int candidate_levels = this->levelStructure(best, label, candidate);
+      if (candidate_levels<=num_levels) { break; }
+      root = best;
+      num_levels = candidate_levels;
+      visited.swap(candidate);
+    }
+    num_levels = this->levelStructure(root, label, visited);
+
+    // no separator available
+    if (num_levels<3) { this->orderLeaf(nodes); return; }
+
+    // separator is the level with fewest nodes adjacent to the next level among the balanced ones
+    std::vector<int> level_size(num_levels, 0), boundary_size(num_levels, 0);
+    for (size_t i=0; i<visited.size(); i++) {
+      int v = visited[i];
+      level_size[level_[v]]++;
+      for (int k=xadj_[v]; k<xadj_[v+1]; k++)
+        if (label_[adj_[k]]==label && level_[adj_[k]]==level_[v]+1) { boundary_size[level_[v]]++; break; }
+    }
+    int separator = -1, size = nodes.size(), count = level_size[0];
+    for (int l=1; l<num_levels-1; count+=level_size[l++]) {
+      if (3*count<size || 3*(count+level_size[l])>2*size) { continue; }
+      if (separator<0 || boundary_size[l]<boundary_size[separator]) { separator = l; }
+    }
+    if (separator<0) {
+      separator = 1;  count = level_size[0];
+      while (separator<num_levels-2 && count+level_size[separator]<size/2) { count += level_size[separator++]; }
+    }
+
+    // only nodes of the separator level adjacent to the next level are kept
+    std::vector<int> first, second, sep;
+    for (size_t i=0; i<visited.size(); i++) {
+      int v = visited[i];
+      if      (level_[v]<separator) { first.push_back(v); }
+      else if (level_[v]>separator) { second.push_back(v); }
+      else {
+        bool is_boundary = false;
+        for (int k=xadj_[v]; k<xadj_[v+1] && !is_boundary; k++)
+          is_boundary = label_[adj_[k]]==label && level_[adj_[k]]==separator+1;
+        if (is_boundary) { sep.push_back(v); }
+        else { first.push_back(v); }
+      }
+    }
+
+    this->dissect(first);
+    this->dissect(second);
+    order_.insert(order_.end(), sep.begin(), sep.end());
+  }
+
+  void NestedDissectionOrdering::orderLeaf(const std::vector<int>& nodes)
+  {
+    int size = nodes.size();
+    if (size<=2) { order_.insert(order_.end(), nodes.begin(), nodes.end()); return; }
+
+    // minimum degree ordering of the subgraph induced by the leaf
+    for (int i=0; i<size; i++) { local_[nodes[i]] = i; }
+
+    std::vector<Eigen::Triplet<double>> coeffs;
+    for (int i=0; i<size; i++) {
+      coeffs.push_back(Eigen::Triplet<double>(i,i,1.0));
+      for (int k=xadj_[nodes[i]]; k<xadj_[nodes[i]+1]; k++)
+        if (local_[adj_[k]]>i) { coeffs.push_back(Eigen::Triplet<double>(i,local_[adj_[k]],1.0)); }
+    }
+    for (int i=0; i<size; i++) { local_[nodes[i]] = -1; }
+
+    Eigen::SparseMatrix<double> leaf(size,size);
+    leaf.setFromTriplets(coeffs.begin(), coeffs.end());
+    PermutationType leaf_perm;
+    Eigen::AMDOrdering<int> ordering;
+    ordering(leaf, leaf_perm);
+
+    for (int i=0; i<size; i++) { order_.push_back(nodes[leaf_perm.indices()[i]]); }
+  }
+
+}
@@ -0,0 +1,125 @@
+/**
+ * @file OrderingCache.cpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-18
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <solver/optimizer/OrderingCache.hpp>
+
+namespace linalg {
+
+  namespace {
+    const char cache_magic[4] = {'K','D','O','C'};
+    const std::int32_t cache_version = 1;
+    std::atomic<unsigned int> tmp_counter(0);
+
+    inline void hashCombine(std::uint64_t& hash, std::uint64_t value) {
+      for (int i=0; i<8; i++) { hash ^= (value >> (8*i)) & 0xff; hash *= 1099511628211ULL; }
+    }
+  }
+
+  std::uint64_t OrderingCache::patternHash(const Eigen::SparseMatrix<double>& mat)
+  {
+    // FNV-1a hash over dimensions, column counts and row indices
+    std::uint64_t hash = 14695981039346656037ULL;
+    hashCombine(hash, mat.rows());
+    hashCombine(hash, mat.cols());
+    for (int col=0; col<mat.outerSize(); col++) {
+      std::uint64_t count = 0;
+      for (Eigen::SparseMatrix<double>::InnerIterator it(mat,col); it; ++it) {
+        hashCombine(hash, it.row());
+        count++;
+      }
+      hashCombine(hash, count);
+    }
+    return hash;
+  }
+
+  std::string OrderingCache::fileName(const std::string& dir, std::uint64_t hash, int ordering) const
+  {
+    std::ostringstream name;
+    name << dir << "/kkt_ordering" << ordering << "_" << std::hex << hash << ".bin";
+    return name.str();
+  }
+
+  bool OrderingCache::isValid(int n) const
+  {
+    if (perm_.size()!=n || parent_.size()!=n || lnnz_.size()!=n) { return false; }
+
+    Eigen::VectorXi visited = Eigen::VectorXi::Zero(n);
+    for (int k=0; k<n; k++) {
+      if (perm_[k]<0 || perm_[k]>=n || visited[perm_[k]]) { return false; }
+      visited[perm_[k]] = 1;
+      if (parent_[k]!=-1 && (parent_[k]<=k || parent_[k]>=n)) { return false; }
+      if (lnnz_[k]<0 || lnnz_[k]>n-1-k) { return false; }
+    }
+    return true;
+  }
+
+  bool OrderingCache::load(const std::string& dir, const Eigen::SparseMatrix<double>& mat, int ordering)
+  {
+    std::uint64_t hash = patternHash(mat);
+    std::ifstream file(fileName(dir, hash, ordering).c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open()) { return false; }
+
+    char magic[4];
+    std::int32_t version, n, nnz;
+    std::uint64_t stored_hash;
+    file.read(magic, 4);
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&stored_hash), sizeof(stored_hash));
+    file.read(reinterpret_cast<char*>(&n), sizeof(n));
+    file.read(reinterpret_cast<char*>(&nnz), sizeof(nnz));
+    if (!file || !std::equal(magic, magic+4, cache_magic) || version!=cache_version ||
+        stored_hash!=hash || n!=mat.cols() || nnz!=mat.nonZeros()) { return false; }
+
+    perm_.resize(n);  parent_.resize(n);  lnnz_.resize(n);
+    file.read(reinterpret_cast<char*>(perm_.data()), n*sizeof(int));
+    file.read(reinterpret_cast<char*>(parent_.data()), n*sizeof(int));
+    file.read(reinterpret_cast<char*>(lnnz_.data()), n*sizeof(int));
+    if (!file || !isValid(n)) { perm_.resize(0); parent_.resize(0); lnnz_.resize(0); return false; }
+
+    return true;
+  }
+
+  bool OrderingCache::save(const std::string& dir, const Eigen::SparseMatrix<double>& mat, int ordering, const Eigen::VectorXi& perm,
+                           const Eigen::VectorXi& parent, const Eigen::VectorXi& lnnz) const
+  {
+    mkdir(dir.c_str(), 0755);
+
+    std::uint64_t hash = patternHash(mat);
+    std::int32_t n = mat.cols(), nnz = mat.nonZeros();
+    std::string name = fileName(dir, hash, ordering);
+    std::ostringstream tmp_name;
+    tmp_name << name << ".tmp" << getpid() << "_" << tmp_counter.fetch_add(1);
+
+    // write to a temporary file unique to this call and rename it, such that concurrent readers never see partial entries
+    {
+      std::ofstream file(tmp_name.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+      if (!file.is_open()) { return false; }
+
+      file.write(cache_magic, 4);
+      file.write(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+      file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+      file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+      file.write(reinterpret_cast<const char*>(&nnz), sizeof(nnz));
+      file.write(reinterpret_cast<const char*>(perm.data()), n*sizeof(int));
+      file.write(reinterpret_cast<const char*>(parent.data()), n*sizeof(int));
+      file.write(reinterpret_cast<const char*>(lnnz.data()), n*sizeof(int));
+      if (!file) { std::remove(tmp_name.str().c_str()); return false; }
+    }
+
+    if (std::rename(tmp_name.str().c_str(), name.c_str())!=0) { std::remove(tmp_name.str().c_str()); return false; }
+    return true;
+  }
+
+}
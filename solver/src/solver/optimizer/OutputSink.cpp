@@ -0,0 +1,60 @@
+/**
+ * @file OutputSink.cpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-19
+ */
+
+#include <cstdio>
+#include <cstdarg>
+#include <solver/optimizer/OutputSink.hpp>
+
+namespace solver {
+
+  void OutputSink::reserve(int num_lines)
+  {
+    // the ring only grows, lines not drained yet are discarded
+    if (num_lines > capacity_) {
+      capacity_ = num_lines;
+      lines_.assign(std::size_t(capacity_)*Line_Size, '\0');
+    }
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+  }
+
+  bool OutputSink::write(const char* format, ...)
+  {
+    long head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= capacity_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(&lines_[std::size_t(head % capacity_)*Line_Size], Line_Size, format, args);
+    va_end(args);
+
+    // the line is published after it has been formatted
+    head_.store(head+1, std::memory_order_release);
+    return true;
+  }
+
+  int OutputSink::drain(std::ostream& stream)
+  {
+    long tail = tail_.load(std::memory_order_relaxed);
+    long head = head_.load(std::memory_order_acquire);
+    int num_lines = head - tail;
+
+    for (; tail<head; tail++) { stream << &lines_[std::size_t(tail % capacity_)*Line_Size]; }
+    tail_.store(tail, std::memory_order_release);
+
+    long dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) { stream << "[" << dropped << " lines of solver output dropped]\n"; }
+    if (num_lines > 0 || dropped > 0) { stream.flush(); }
+    return num_lines;
+  }
+
+}
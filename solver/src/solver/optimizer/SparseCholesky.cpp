@@ -44,13 +44,16 @@
  * 
  */
 
+#include <algorithm>
 #include <solver/optimizer/SparseCholesky.hpp>
 
 namespace linalg {
 
-  void SparseCholesky::analyzePattern(const Eigen::SparseMatrix<double>& mat, const solver::SolverSetting& setting)
+  void SparseCholesky::resize(const Eigen::SparseMatrix<double>& mat, const solver::SolverSetting& setting)
   {
-    setting_ = std::make_shared<const solver::SolverSetting>(setting);
+    // only the regularization is read from the setting, no copy of it is kept
+    delta_ = setting.get(solver::SolverDoubleParam_DynamicRegularization);
+    eps_ = setting.get(solver::SolverDoubleParam_DynamicRegularizationThresh);
 
     n_ = mat.cols();
     X_.resize(n_);
@@ -61,7 +64,26 @@ namespace linalg {
     L_.resize(n_,n_);
     Parent_.resize(n_);
     Pattern_.resize(n_);
-    std::vector<Eigen::Triplet<double>> coeffs;
+  }
+
+  void SparseCholesky::allocateFactor()
+  {
+    // column pointers from column counts, row indices are written by the numeric factorization
+    int* Lp = L_.outerIndexPtr();
+    Lp[0] = 0;
+    for (int col=0; col<n_; col++) { Lp[col+1] = Lp[col] + Lnnz_[col]; }
+    L_.resizeNonZeros(Lp[n_]);
+
+    int* Li = L_.innerIndexPtr();
+    for (int col=0; col<n_; col++)
+      for (int row=0; row<Lnnz_[col]; row++)
+        Li[Lp[col]+row] = row;
+    Eigen::Map<Eigen::VectorXd>(L_.valuePtr(), Lp[n_]).setOnes();
+  }
+
+  void SparseCholesky::analyzePattern(const Eigen::SparseMatrix<double>& mat, const solver::SolverSetting& setting)
+  {
+    this->resize(mat, setting);
 
     int* Lnnz = Lnnz_.data();
     int* Flag = Flag_.data();
@@ -79,11 +101,30 @@ namespace linalg {
         }
     }
 
-    for (int col=0; col<n_; col++)
-      for (int row=0; row<Lnnz[col]; row++)
-        coeffs.push_back(Eigen::Triplet<double>(int(row%n_),col,1.0));
-    L_.setFromTriplets(coeffs.begin(), coeffs.end());
-    if (!L_.isCompressed()) { L_.makeCompressed(); }
+    this->allocateFactor();
+  }
+
+  double SparseCholesky::factorFlops() const
+  {
+    double flops = 0.0;
+    const int* Lp = L_.outerIndexPtr();
+    for (int j=0; j<n_; j++) {
+      double lnz = Lp[j+1]-Lp[j];
+      flops += lnz*(lnz+3.0);
+    }
+    return flops;
+  }
+
+  int SparseCholesky::eliminationTreeHeight() const
+  {
+    // parents have larger indices than their children
+    int height = 0;
+    Eigen::VectorXi depth(n_);
+    for (int k=n_-1; k>=0; k--) {
+      depth[k] = Parent_[k]<0 ? 1 : depth[Parent_[k]]+1;
+      height = std::max(height, depth[k]);
+    }
+    return height;
   }
 
   int SparseCholesky::factorize(const Eigen::SparseMatrix<double>& mat, const Eigen::Ref<const Eigen::VectorXd>& sign)
@@ -104,8 +145,6 @@ namespace linalg {
     const int* Ai = mat.innerIndexPtr();
 
     int p, len;
-    delta_ = this->getSetting().get(solver::SolverDoubleParam_DynamicRegularization);
-    eps_ = this->getSetting().get(solver::SolverDoubleParam_DynamicRegularizationThresh);
 
     for (int k=0; k<mat.outerSize(); k++) {
       // nonzero pattern of kth row of L
@@ -165,6 +204,36 @@ namespace linalg {
         x[j] -= Lx[p] * x[Li[p]];
   }
 
+  void SparseCholesky::solve(Eigen::Ref<Eigen::MatrixXd> eig_x)
+  {
+    // right hand sides in the columns of x are solved in place, each column of
+    // the factor is streamed from memory once and applied to all of them
+    double* D = D_.data();
+    double* Lx = L_.valuePtr();
+    int* Lp = L_.outerIndexPtr();
+    int* Li = L_.innerIndexPtr();
+    int n = eig_x.rows(), nrhs = eig_x.cols(), ld = eig_x.outerStride();
+    double* x_end = eig_x.data()+nrhs*ld;
+
+    for (int j=0; j<n; j++)
+      for (double* x=eig_x.data(); x<x_end; x+=ld) {
+        double xj = x[j];
+        for (int p=Lp[j]; p<Lp[j+1]; p++)
+          x[Li[p]] -= Lx[p]*xj;
+      }
+
+    for (double* x=eig_x.data(); x<x_end; x+=ld)
+      for (int j=0; j<n; j++) { x[j] /= D[j]; }
+
+    for (int j=n-1; j>=0; j--)
+      for (double* x=eig_x.data(); x<x_end; x+=ld) {
+        double xj = x[j];
+        for (int p=Lp[j]; p<Lp[j+1]; p++)
+          xj -= Lx[p]*x[Li[p]];
+        x[j] = xj;
+      }
+  }
+
   Eigen::VectorXd& SparseCholesky::solve(const Eigen::VectorXd& b)
   {
     X_ = b;
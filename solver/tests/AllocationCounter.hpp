@@ -0,0 +1,35 @@
+/**
+ * @file AllocationCounter.hpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Counts the heap allocations of all threads while count_allocations is set,
+ * to check that real-time paths do not allocate. It replaces malloc, calloc
+ * and realloc, so it is included by exactly one translation unit of an
+ * executable. On platforms other than glibc nothing is counted and
+ * num_allocations stays at -1.
+ */
+#ifdef __GLIBC__
+  extern "C" void* __libc_malloc(size_t size);
+  extern "C" void* __libc_calloc(size_t num, size_t size);
+  extern "C" void* __libc_realloc(void* ptr, size_t size);
+
+  static std::atomic<bool> count_allocations(false);
+  static std::atomic<long> num_allocations(0);
+
+  extern "C" void* malloc(size_t size) { if (count_allocations) { num_allocations++; } return __libc_malloc(size); }
+  extern "C" void* calloc(size_t num, size_t size) { if (count_allocations) { num_allocations++; } return __libc_calloc(num, size); }
+  extern "C" void* realloc(void* ptr, size_t size) { if (count_allocations) { num_allocations++; } return __libc_realloc(ptr, size); }
+#else
+  static std::atomic<bool> count_allocations(false);
+  static std::atomic<long> num_allocations(-1);
+#endif
@@ -12,6 +12,8 @@
 #include <test_problems/TestProblem01.hpp>
 #include <test_problems/TestProblem02.hpp>
 #include <test_problems/TestProblem03.hpp>
+#include <test_problems/TestProblem04.hpp>
+#include <test_problems/TestProblem05.hpp>
 
 #define PRECISION 0.01
 
@@ -106,3 +108,158 @@
     check_matrix(OptVec, ref_x);
     EXPECT_NEAR(OptVal, ref_objval, PRECISION);
   }
+
+  TEST_F(LbfgsTest, LbfgsTest04)
+  {
+    // Reference values
+    Eigen::Vector4d ref_x(1.165, 4.312, 4.307, 1.172);
+    double ref_objval = 17.6919;
+
+    // Build nonlinear problem with analytic derivatives
+    nlp_test_problems::TestProblem04 toy_problem;
+
+    // Build solver
+    LbfgsSolver solver;
+    solver.initialize(&toy_problem, 5.);
+    solver.verbose() = false;
+    solver.opt_params().max_iterations = 10;
+    solver.optimize();
+
+    // Retrieve optimal values
+    Eigen::VectorXd OptVec = toy_problem.optimalVector();
+    double OptVal = toy_problem.optimalValue();
+
+    // Compare optimal values and reference, gradient requires a single objective evaluation
+    check_matrix(OptVec, ref_x);
+    EXPECT_NEAR(OptVal, ref_objval, PRECISION);
+    EXPECT_LE(toy_problem.numObjectiveEvaluations(), 4*solver.opt_params().max_iterations);
+  }
+
+  TEST_F(LbfgsTest, LbfgsTest05)
+  {
+    // Build nonlinear problems
+    nlp_test_problems::TestProblem03 serial_problem, parallel_problem;
+
+    // Build solvers, the second one shares finite differences among threads
+    LbfgsSolver serial_solver, parallel_solver;
+    serial_solver.initialize(&serial_problem, 0.);
+    serial_solver.num_threads() = 1;
+    serial_solver.optimize();
+    parallel_solver.initialize(&parallel_problem, 0.);
+    parallel_solver.num_threads() = 4;
+    parallel_solver.optimize();
+
+    // Compare optimal values, gradients are identical regardless of the number of threads
+    Eigen::VectorXd ref_x(100); ref_x.setOnes();
+    check_matrix(parallel_problem.optimalVector(), ref_x);
+    check_matrix(parallel_problem.optimalVector(), serial_problem.optimalVector());
+    EXPECT_EQ(parallel_problem.optimalValue(), serial_problem.optimalValue());
+  }
+
+  TEST_F(LbfgsTest, LbfgsTest06)
+  {
+    // Reference values
+    Eigen::VectorXd ref_x(100);
+    for (int i=0; i<100; i+=2) { ref_x(i) = 0.5;  ref_x(i+1) = 0.25; }
+    double ref_objval = 12.5;
+
+    // Build nonlinear problems
+    nlp_test_problems::TestProblem05 toy_problem, penalty_problem;
+
+    // Build solvers, the first one handles the bounds exactly
+    LbfgsSolver solver, penalty_solver;
+    solver.initialize(&toy_problem, 0.);
+    solver.exact_bounds() = true;
+    solver.optimize();
+    penalty_solver.initialize(&penalty_problem, 1.e3);
+    penalty_solver.optimize();
+
+    // Retrieve optimal values
+    Eigen::VectorXd OptVec = toy_problem.optimalVector();
+    double OptVal = toy_problem.optimalValue();
+
+    // Compare optimal values and reference, bounds hold exactly and the penalized solution is less accurate
+    check_matrix(OptVec, ref_x);
+    EXPECT_NEAR(OptVal, ref_objval, PRECISION);
+    for (int i=0; i<100; i+=2) { EXPECT_LE(OptVec(i), 0.5); }
+    EXPECT_LT((OptVec-ref_x).norm(), (penalty_problem.optimalVector()-ref_x).norm());
+  }
+
+  TEST_F(LbfgsTest, LbfgsTest07)
+  {
+    // Build nonlinear problem, constraints are penalized and bounds handled exactly
+    nlp_test_problems::TestProblem04 toy_problem;
+
+    // Build solver
+    LbfgsSolver solver;
+    solver.initialize(&toy_problem, 5.);
+    solver.exact_bounds() = true;
+    solver.optimize();
+
+    // Retrieve optimal values
+    Eigen::VectorXd OptVec = toy_problem.optimalVector();
+
+    // Bounds hold exactly and penalized constraints approximately
+    for (int i=0; i<4; i++) { EXPECT_GE(OptVec(i), 1.);  EXPECT_LE(OptVec(i), 5.); }
+    EXPECT_NEAR(OptVec.squaredNorm(), 40., 1.);
+  }
+
+  TEST_F(LbfgsTest, LbfgsTest08)
+  {
+    // Reference values
+    Eigen::Vector4d ref_x(1.0, 4.743, 3.821, 1.379);
+    double ref_objval = 17.014;
+
+    // Build nonlinear problems
+    nlp_test_problems::TestProblem04 toy_problem, penalty_problem;
+    SolverSetting setting;
+    setting.initialize(TEST_PATH+std::string("default_stgs.yaml"));
+
+    // Build solvers, constraints are enforced with an augmented lagrangian or a large penalty
+    LbfgsSolver solver, penalty_solver;
+    solver.initialize(&toy_problem, setting);
+    solver.exact_bounds() = true;
+    solver.optimize();
+    penalty_solver.initialize(&penalty_problem, 1.e4);
+    penalty_solver.exact_bounds() = true;
+    penalty_solver.optimize();
+
+    // Retrieve optimal values
+    Eigen::VectorXd OptVec = toy_problem.optimalVector();
+    double OptVal = toy_problem.optimalValue();
+
+    // Compare optimal values and reference, constraints hold within the feasibility tolerance
+    check_matrix(OptVec, ref_x);
+    EXPECT_NEAR(OptVal, ref_objval, PRECISION);
+    EXPECT_GE(OptVec.prod(), 25.-setting.get(SolverDoubleParam_AugLagFeasibilityTol));
+    EXPECT_NEAR(OptVec.squaredNorm(), 40., setting.get(SolverDoubleParam_AugLagFeasibilityTol));
+    EXPECT_LT(toy_problem.numObjectiveEvaluations(), penalty_problem.numObjectiveEvaluations());
+  }
+
+  TEST_F(LbfgsTest, LbfgsTest09)
+  {
+    // f(x) = x^4/4 - x^2/2 is concave around the origin, the first step gives a pair with negative curvature
+    lbfgs_evaluate_t evaluate = [](void*, const double* x, double* g, const int, const double) {
+      g[0] = x[0]*x[0]*x[0] - x[0];
+      return 0.25*x[0]*x[0]*x[0]*x[0] - 0.5*x[0]*x[0];
+    };
+    lbfgs_progress_t progress = [](void*, const double*, const double*, const double, const double,
+                                   const double, const double, int, int k, int) { return k < 2 ? 0 : 1; };
+
+    // A full memory of a single pair, stopped right after the rejected pair
+    lbfgs_parameter_t param;
+    lbfgs_parameter_init(&param);
+    param.m = 1;
+    lbfgsb_memory_t memory;
+    memory.s = memory.y = Eigen::MatrixXd::Ones(1, 1);
+    memory.num_pairs = 1;  memory.end = 0;  memory.theta = 1.;
+
+    double x = 0.1, fx;
+    double lower = -std::numeric_limits<double>::infinity(), upper = std::numeric_limits<double>::infinity();
+    lbfgsb(1, &x, &fx, &lower, &upper, evaluate, progress, NULL, &param, &memory);
+
+    // The rejected pair leaves the stored one untouched
+    EXPECT_EQ(1, memory.num_pairs);
+    EXPECT_EQ(1., memory.s(0,0));
+    EXPECT_EQ(1., memory.y(0,0));
+  }
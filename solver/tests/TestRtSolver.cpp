@@ -10,6 +10,7 @@
 #include <yaml-cpp/yaml.h>
 
 #include <solver/interface/Solver.hpp>
+#include "AllocationCounter.hpp"
 
 #define PRECISION 0.01
 #define REDUCED_PRECISION 0.06
@@ -194,3 +195,231 @@ using namespace rt_solver;
     for (int id=0; id<solution.size(); id++)
       EXPECT_NEAR(solution[id], rt_model.hqp_solver_.solution()[id], PRECISION);
   }
+
+  // Testing warm start of the real-time qp solver from the previous active set
+  TEST_F(RtSolverTest, QPSolverWarmStartTest01)
+  {
+    RtQPSolver<Num_OptVars, Max_Eq_Rows, Max_Ineq_Rows> qp_solver;
+    RtQPSolverInterface<Num_OptVars, Max_Eq_Rows, Max_Ineq_Rows>& qp = qp_solver;
+    qp.warmStart() = true;
+
+    // min 0.5 x'x + g'x  s.t.  x <= 0.5
+    for (double g : {-1.0, -1.01, 1.0}) {
+      qp.reset(Num_OptVars, 0, 0);
+      qp.objectiveQuadPart().setIdentity();
+      qp.objectiveLinPart().setConstant(g);
+      qp.appendInequalities(Eigen::Matrix4d::Identity(), Eigen::Vector4d::Constant(-0.5));
+      EXPECT_TRUE(qp.optimize());
+
+      // the active set does not change between the first two problems
+      if (g == -1.0) { EXPECT_EQ(4, qp.numAddSteps()); }
+      if (g == -1.01) { EXPECT_EQ(0, qp.numAddSteps()); EXPECT_EQ(0, qp.numDropSteps()); }
+      EXPECT_EQ(g<0.0 ? 4 : 0, qp.activeSet().size());
+      for (int id=0; id<Num_OptVars; id++)
+        EXPECT_NEAR(std::min(-g, 0.5), qp.solution()[id], PRECISION);
+    }
+  }
+
+  // Testing reuse and rank one updates of the cached hessian factorization
+  TEST_F(RtSolverTest, QPSolverHessianCacheTest01)
+  {
+    RtQPSolver<Num_OptVars, Max_Eq_Rows, Max_Ineq_Rows> qp_solver;
+    RtQPSolverInterface<Num_OptVars, Max_Eq_Rows, Max_Ineq_Rows>& qp = qp_solver;
+    EXPECT_EQ(-1, qp_solver.maxRankUpdates());
+    qp_solver.maxRankUpdates() = 2;
+
+    Eigen::Matrix4d hessian;
+    hessian << 4.0, 1.0, 0.0, 0.0,
+               1.0, 3.0, 1.0, 0.0,
+               0.0, 1.0, 2.0, 0.5,
+               0.0, 0.0, 0.5, 1.0;
+    Eigen::Vector4d gradient(1.0, -2.0, 0.5, -1.0), weights(0.0, 0.0, 0.5, 0.0), v(1.0, 2.0, 0.0, -1.0);
+
+    // identical hessian, diagonal change, explicit rank one update and a full change
+    for (int trial=0; trial<4; trial++) {
+      if (trial == 1) { hessian += weights.asDiagonal(); }
+      if (trial == 3) { hessian(0,1) = hessian(1,0) = 0.5; }
+
+      qp.reset(Num_OptVars, 0, 0);
+      qp.objectiveQuadPart() = hessian;
+      qp.objectiveLinPart() = gradient;
+      qp.appendInequalities(Eigen::RowVector4d(1.0, 1.0, 1.0, 1.0), Eigen::Matrix<double,1,1>(-0.5));
+      if (trial == 2) { qp_solver.hessianRankUpdate(v, 0.3);  hessian += 0.3*v*v.transpose(); }
+      EXPECT_TRUE(qp.optimize());
+
+      int num_factorizations[] = {1, 1, 1, 2};
+      EXPECT_EQ(num_factorizations[trial], qp_solver.numFactorizations());
+
+      // compare against solution of the kkt system of the active inequality
+      Eigen::Matrix<double,5,5> kkt = Eigen::Matrix<double,5,5>::Zero();
+      kkt.topLeftCorner<4,4>() = hessian;
+      kkt.block<4,1>(0,4).setOnes();
+      kkt.block<1,4>(4,0).setOnes();
+      Eigen::Matrix<double,5,1> rhs;  rhs << -gradient, 0.5;
+      Eigen::Matrix<double,5,1> sol = kkt.lu().solve(rhs);
+      if (sol[4] < 0.0) { sol.head<4>() = -hessian.ldlt().solve(gradient); }
+      for (int id=0; id<Num_OptVars; id++)
+        EXPECT_NEAR(sol[id], qp.solution()[id], 1.e-6);
+    }
+  }
+
+  // Testing hand off of nullspace computations to the svd thread, with and without parking, and inline
+  TEST_F(RtSolverTest, HQPSolverSVDHandoffTest01)
+  {
+    for (int config=0; config<3; config++) {
+      YAML::Node hqp_solver_pars;
+      hqp_solver_pars["svd_spin_count"] = (config == 1 ? 0 : 10000);
+      hqp_solver_pars["svd_inline_size"] = (config == 2 ? Max_Eq_Rows*Num_OptVars : 0);
+
+      RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> rt_model(hqp_solver_pars);
+      ConeConstraints<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> cons_A(rt_model);
+      HyperConstraints<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> cons_B(rt_model);
+      rt_model.subCostComposers().push_back(static_cast<RtHQPCost*>(&cons_A));
+      rt_model.subCostComposers().push_back(static_cast<RtHQPCost*>(&cons_B));
+      rt_model.initialize();
+
+      Eigen::Vector4d solution; solution << 2.0, 5.0, 0.0, 0.0;
+      for (int tick=0; tick<100; tick++) {
+        EXPECT_TRUE(rt_model.solve());
+        for (int id=0; id<solution.size(); id++)
+          EXPECT_NEAR(solution[id], rt_model.hqp_solver_.solution()[id], PRECISION);
+      }
+    }
+  }
+
+  // Testing nullspace maps from column pivoting qr against singular value decomposition
+  TEST_F(RtSolverTest, NullspaceQRTest01)
+  {
+    RtMatrix<3,5>::d mat(3,5);
+    mat << 1.0, 2.0, 0.0, -1.0, 0.5,
+           0.0, 1.0, 1.0,  2.0, 0.0,
+           1.0, 3.0, 1.0,  1.0, 0.5;  // third row is sum of the others
+
+    RtMatrix<5,5>::d null_svd, null_qr;
+    Eigen::JacobiSVD<RtMatrix<3,5>::d> mat_svd(mat, Eigen::ComputeFullV);
+    RtMatrix<5,3>::d mat_transp = mat.transpose();
+    Eigen::ColPivHouseholderQR<RtMatrix<5,3>::d> mat_transp_qr(mat_transp);
+
+    EXPECT_EQ(2, RtMatrixUtils::computeNullspaceMap(mat, null_svd, mat_svd, 1.e8));
+    EXPECT_EQ(2, RtMatrixUtils::computeNullspaceMap(mat, null_qr, mat_transp_qr, 1.e8));
+    EXPECT_EQ(3, null_qr.cols());
+    EXPECT_NEAR(0.0, (mat*null_qr).norm(), 1.e-10);
+    EXPECT_NEAR(0.0, (null_qr.transpose()*null_qr - Eigen::Matrix3d::Identity()).norm(), 1.e-10);
+
+    // both bases span the same space
+    EXPECT_NEAR(0.0, (null_svd*null_svd.transpose() - null_qr*null_qr.transpose()).norm(), 1.e-10);
+
+    // hierarchy solved with qr nullspaces
+    YAML::Node hqp_solver_pars;
+    hqp_solver_pars["nullspace_qr"] = true;
+    RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> rt_model(hqp_solver_pars);
+    ConeConstraints<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> cons_A(rt_model);
+    HyperConstraints<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> cons_B(rt_model);
+    rt_model.subCostComposers().push_back(static_cast<RtHQPCost*>(&cons_A));
+    rt_model.subCostComposers().push_back(static_cast<RtHQPCost*>(&cons_B));
+    rt_model.initialize();
+    EXPECT_TRUE(rt_model.solve());
+
+    Eigen::Vector4d solution; solution << 2.0, 5.0, 0.0, 0.0;
+    for (int id=0; id<solution.size(); id++)
+      EXPECT_NEAR(solution[id], rt_model.hqp_solver_.solution()[id], PRECISION);
+  }
+
+  // Testing hierarchies deeper than the default depth and reuse of nullspaces and hessian factors between solves
+  TEST_F(RtSolverTest, HQPSolverDepthTest01)
+  {
+    static const int Num_Ranks = 9;
+    YAML::Node hqp_solver_pars;
+    RtModel<Max_Ineq_Rows, Max_Eq_Rows, 2*Num_Ranks, Num_Ranks> rt_model(hqp_solver_pars);
+
+    // one variable is fixed per rank, the others only through inequalities of the first rank
+    rt_model.clean();
+    for (int rank=0; rank<Num_Ranks; rank++)
+      rt_model.addLinConstr(rt_model.getVar(rank), "=", double(rank), rank);
+    rt_model.addLinConstr(rt_model.getVar(Num_Ranks), ">", 1.0, 0);
+
+    int num_factorizations = 0;
+    rt_model.initialize();
+    for (int tick=0; tick<3; tick++) {
+      EXPECT_TRUE(rt_model.solve());
+      EXPECT_EQ(Num_Ranks, rt_model.n_solved_ranks_);
+      EXPECT_EQ(tick == 0 ? 0 : Num_Ranks, rt_model.hqp_solver_.numReusedFactorizations());
+
+      // every rank keeps its own hessian factor, only the first solve factorizes
+      if (tick == 0) { num_factorizations = rt_model.hqp_solver_.qpNumFactorizations(); }
+      EXPECT_LE(Num_Ranks, num_factorizations);
+      EXPECT_EQ(num_factorizations, rt_model.hqp_solver_.qpNumFactorizations());
+
+      for (int rank=0; rank<Num_Ranks; rank++)
+        EXPECT_NEAR(double(rank), rt_model.hqp_solver_.solution()[rank], PRECISION);
+      EXPECT_NEAR(1.0, rt_model.hqp_solver_.solution()[Num_Ranks], PRECISION);
+    }
+  }
+
+#ifdef __GLIBC__
+  /*
+   * Sub-cost composer that formulates its constraints on fixed-size
+   * row blocks, without going through solver::LinExpr
+   */
+
+  template<int Max_Ineq_Rows, int Max_Eq_Rows, int Num_OptVars>
+  class TrackingConstraints : public rt_solver::RtHQPCost
+  {
+    public:
+      typedef RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> RtModel_;
+
+    public:
+      TrackingConstraints(RtModel_& prob_composer)
+        : prob_composer_(&prob_composer)
+      {
+        cone_mat_ << -1.0,  1.0,  0.0,  0.0,
+                      1.0,  1.0,  0.0,  0.0;
+        cone_vec_ = Eigen::Vector2d(1.0, 1.0);
+        target_mat_.setIdentity();
+        target_vec_.setZero();
+      }
+      virtual ~TrackingConstraints() {}
+
+      void updateAfterSolutionFound() {}
+      int maxRank() const { return 1; }
+      void addCostToHierarchy(int rank) const
+      {
+        if (rank == 0) { prob_composer_->addLinConstr(cone_mat_, '>', cone_vec_); }
+        else if (rank == 1) { prob_composer_->addLinConstr(target_mat_.template topRows<2>(), '=', target_vec_); }
+      }
+
+      Eigen::Vector2d& target() { return target_vec_; }
+
+    private:
+      RtModel_ *prob_composer_;
+
+      Eigen::Vector2d cone_vec_, target_vec_;
+      Eigen::Matrix<double, 2, 4> cone_mat_;
+      Eigen::Matrix<double, 4, 4> target_mat_;
+  };
+
+  // Testing that control ticks of a model composed on fixed-size row blocks do not allocate
+  TEST_F(RtSolverTest, HQPSolverAllocationFreeTest01)
+  {
+    YAML::Node hqp_solver_pars;
+    RtModel<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> rt_model(hqp_solver_pars);
+    TrackingConstraints<Max_Ineq_Rows, Max_Eq_Rows, Num_OptVars> cons(rt_model);
+    rt_model.subCostComposers().push_back(static_cast<RtHQPCost*>(&cons));
+    rt_model.initialize();
+
+    for (int tick=0; tick<50; tick++) {
+      cons.target() = Eigen::Vector2d(2.0+0.01*tick, 5.0);
+
+      // the first tick is excluded, as it may set up buffers of the svd thread
+      num_allocations = 0;
+      count_allocations = (tick > 0);
+      bool is_valid = rt_model.solve();
+      count_allocations = false;
+
+      EXPECT_TRUE(is_valid);
+      EXPECT_EQ(0, num_allocations.load());
+      EXPECT_NEAR(2.0+0.01*tick, rt_model.hqp_solver_.solution()[0], PRECISION);
+      EXPECT_NEAR(5.0, rt_model.hqp_solver_.solution()[1], PRECISION);
+    }
+  }
+#endif
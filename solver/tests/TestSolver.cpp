@@ -10,9 +10,15 @@
  */
 
 
+#include <atomic>
+#include <fstream>
+#include <dirent.h>
+#include <thread>
+#include <sstream>
 #include <gtest/gtest.h>
 #include <yaml_cpp_catkin/yaml_cpp_fwd.hpp>
 #include <solver/interface/Solver.hpp>
+#include <solver/optimizer/NestedDissection.hpp>
 
 #define PRECISION 0.01
 #define REDUCED_PRECISION 0.06
@@ -192,6 +198,30 @@ void testProblem(const std::string cfg_file, const ExitCode expected_code, bool
 	EXPECT_NEAR(static_cast<int>(expected_code), static_cast<int>(exit_code), PRECISION);
 }
 
+// Solves a problem of the test set with one parameter of the default setting changed,
+// returns the exit code, the values of the variables and the objective
+template <typename Param, typename Value>
+ExitCode solveWithSetting(const std::string cfg_file, Param param, const Value& value, std::vector<double>& xopt, double& objective)
+{
+	Model model;
+	std::vector<Var> vars;
+	ProblemData data(TEST_PATH+cfg_file, false);
+	model.configSetting(TEST_PATH+std::string("default_stgs.yaml"));
+	model.getSetting().set(SolverBoolParam_Verbose, false);
+	model.getSetting().set(param, value);
+
+	buildProblemFromData(model, data, vars);
+	ExitCode exit_code = model.optimize();
+
+	xopt.clear();
+	objective = 0.0;
+	for (int var_id=0; var_id<data.numVars(); var_id++) {
+	  xopt.push_back(vars[var_id].get(SolverDoubleParam_X));
+	  objective += data.c()[var_id]*xopt.back();
+	}
+	return exit_code;
+}
+
 // Testing Branch and Bound Solver
 TEST_F(SolverTest, BnBSolverTest01)
 {
@@ -231,7 +261,6 @@ TEST_F(SolverTest, BnBSolverTest07)
   testProblem(TEST_PATH+std::string("test_BnB_07.yaml"), ExitCode::Optimal);
 }
 
-
 // Testing Interior Point Solver
 TEST_F(SolverTest, InteriorPointSolverTest01)
 {
@@ -323,3 +352,384 @@ TEST_F(SolverTest, InteriorPointSolverTest18)
   testProblem(TEST_PATH+std::string("test_18.yaml"), ExitCode::Optimal);
 }
 
+// Testing bounds on single variables handled as box constraints
+TEST_F(SolverTest, BoxConstraintsTest01)
+{
+  Model model;
+  model.configSetting(TEST_PATH+std::string("default_stgs.yaml"));
+  model.getSetting().set(SolverBoolParam_Verbose, false);
+
+  Var x0 = model.addVar(VarType::Continuous, 0.0, 1.0, 0.5);
+  Var x1 = model.addVar(VarType::Continuous, 0.0, 1.0, 0.5);
+  model.addLinConstr(LinExpr(x0) + LinExpr(x1), "<", 1.5);
+  model.addLinConstr(LinExpr(x0), ">", 0.0);
+  model.addLinConstr(LinExpr(x0), "<", 1.0);
+  model.addLinConstr(LinExpr(x1), ">", 0.0);
+  model.addLinConstr(LinExpr(x1)*2.0, "<", 2.0);
+
+  DCPQuadExpr qexpr;
+  model.setObjective(qexpr, LinExpr(x0)*(-1.0) - LinExpr(x1)*2.0);
+  ExitCode exit_code = model.optimize();
+
+  EXPECT_NEAR(static_cast<int>(ExitCode::Optimal), static_cast<int>(exit_code), PRECISION);
+  EXPECT_NEAR(0.5, x0.get(SolverDoubleParam_X), PRECISION);
+  EXPECT_NEAR(1.0, x1.get(SolverDoubleParam_X), PRECISION);
+}
+
+// Testing reuse of cached fill-reducing orderings
+TEST_F(SolverTest, OrderingCacheTest01)
+{
+  double objective;
+  std::vector<double> xopt, xcached;
+  std::string cache_dir = ::testing::TempDir() + "solver_ordering_cache";
+  EXPECT_EQ(ExitCode::Optimal, solveWithSetting("test_05.yaml", SolverStringParam_OrderingCacheDir, cache_dir, xopt, objective));
+  EXPECT_EQ(ExitCode::Optimal, solveWithSetting("test_05.yaml", SolverStringParam_OrderingCacheDir, cache_dir, xcached, objective));
+  for (size_t var_id=0; var_id<xopt.size(); var_id++) { EXPECT_NEAR(xopt[var_id], xcached[var_id], PRECISION); }
+
+  // entries with column counts that do not match the pattern are detected and replaced
+  int num_entries = 0;
+  DIR* dir = opendir(cache_dir.c_str());
+  ASSERT_NE(nullptr, dir);
+  while (dirent* entry = readdir(dir)) {
+    std::string name = cache_dir + "/" + entry->d_name;
+    if (name.size()<4 || name.compare(name.size()-4, 4, ".bin")!=0) { continue; }
+    std::fstream file(name.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    std::int32_t n, lnnz = 0;
+    file.seekg(16);
+    file.read(reinterpret_cast<char*>(&n), sizeof(n));
+    file.seekp(24+2*n*sizeof(std::int32_t));
+    file.write(reinterpret_cast<const char*>(&lnnz), sizeof(lnnz));
+    num_entries++;
+  }
+  closedir(dir);
+  EXPECT_GT(num_entries, 0);
+  EXPECT_EQ(ExitCode::Optimal, solveWithSetting("test_05.yaml", SolverStringParam_OrderingCacheDir, cache_dir, xcached, objective));
+  for (size_t var_id=0; var_id<xopt.size(); var_id++) { EXPECT_NEAR(xopt[var_id], xcached[var_id], PRECISION); }
+}
+
+// Testing nested dissection ordering of the kkt matrix against approximate minimum degree
+TEST_F(SolverTest, NestedDissectionTest01)
+{
+  double objective;
+  std::vector<double> xamd, xnd;
+  EXPECT_EQ(ExitCode::Optimal, solveWithSetting("test_05.yaml", SolverIntParam_KktOrdering, static_cast<int>(KktOrdering::Amd), xamd, objective));
+  EXPECT_EQ(ExitCode::Optimal, solveWithSetting("test_05.yaml", SolverIntParam_KktOrdering, static_cast<int>(KktOrdering::NestedDissection), xnd, objective));
+  for (size_t var_id=0; var_id<xamd.size(); var_id++) { EXPECT_NEAR(xamd[var_id], xnd[var_id], PRECISION); }
+}
+
+// Testing nested dissection of kkt matrices with many isolated nodes, such as variables with only box constraints
+TEST_F(SolverTest, NestedDissectionTest02)
+{
+  // diagonal pattern with a chain at its end
+  int n = 200000;
+  std::vector<Eigen::Triplet<double>> coeffs;
+  for (int i=0; i<n; i++) { coeffs.push_back(Eigen::Triplet<double>(i, i, 1.0)); }
+  for (int i=n-500; i<n-1; i++) { coeffs.push_back(Eigen::Triplet<double>(i, i+1, 1.0)); }
+  Eigen::SparseMatrix<double> pattern(n, n);
+  pattern.setFromTriplets(coeffs.begin(), coeffs.end());
+
+  linalg::NestedDissectionOrdering ordering;
+  linalg::NestedDissectionOrdering::PermutationType perm;
+  ordering(pattern, perm);
+  std::vector<bool> is_ordered(n, false);
+  for (int i=0; i<n; i++) { is_ordered[perm.indices()[i]] = true; }
+  EXPECT_EQ(n, std::count(is_ordered.begin(), is_ordered.end(), true));
+
+  // bound-only variables are isolated nodes of the kkt matrix, a few are coupled by one constraint
+  std::vector<double> objectives;
+  for (KktOrdering kkt_ordering : {KktOrdering::Amd, KktOrdering::NestedDissection}) {
+    Model model;
+    model.configSetting(TEST_PATH+std::string("default_stgs.yaml"));
+    model.getSetting().set(SolverBoolParam_Verbose, false);
+    model.getSetting().set(SolverIntParam_KktOrdering, static_cast<int>(kkt_ordering));
+
+    std::vector<Var> vars;
+    LinExpr objective, coupling;
+    for (int var_id=0; var_id<1000; var_id++) {
+      vars.push_back(model.addVar(VarType::Continuous, -1.0, 1.0, 0.0));
+      model.addLinConstr(LinExpr(vars.back()), ">", -1.0);
+      model.addLinConstr(LinExpr(vars.back()), "<", 1.0);
+      objective += LinExpr(vars.back())*(var_id%2==0 ? 1.0 : -0.5);
+      if (var_id<100 && var_id%2==0) { coupling += LinExpr(vars.back()); }
+    }
+    model.addLinConstr(coupling, ">", -10.0);
+    model.setObjective(DCPQuadExpr(), objective);
+    EXPECT_EQ(ExitCode::Optimal, model.optimize());
+
+    objectives.push_back(0.0);
+    for (int var_id=0; var_id<1000; var_id++) { objectives.back() += (var_id%2==0 ? 1.0 : -0.5)*vars[var_id].get(SolverDoubleParam_X); }
+  }
+  EXPECT_NEAR(-710.0, objectives[0], 1.e-3);
+  EXPECT_NEAR(objectives[0], objectives[1], 1.e-6*std::abs(objectives[0]));
+}
+
+// Testing direct assembly of constraint matrices against assembly from triplets
+TEST_F(SolverTest, MatrixAssemblyTest01)
+{
+  std::vector<Eigen::Triplet<double>> coeffs;
+  for (int id=0; id<200; id++) {
+    int row = (37*id)%23, col = (11*id+5)%17;
+    coeffs.push_back(Eigen::Triplet<double>(row, col, 0.5*id-20.0));
+  }
+  coeffs.push_back(Eigen::Triplet<double>(3, 4, 1.0));
+  coeffs.push_back(Eigen::Triplet<double>(3, 4, 2.0));
+
+  SolverStorage storage;
+  Eigen::SparseMatrix<double> expected(23,17), assembled(23,17);
+  expected.setFromTriplets(coeffs.begin(), coeffs.end());
+  storage.assembleMatrix(coeffs, assembled);
+
+  EXPECT_TRUE(assembled.isCompressed());
+  EXPECT_EQ(expected.nonZeros(), assembled.nonZeros());
+  for (int col=0; col<=assembled.cols(); col++) { EXPECT_EQ(expected.outerIndexPtr()[col], assembled.outerIndexPtr()[col]); }
+  for (int k=0; k<assembled.nonZeros(); k++) {
+    EXPECT_EQ(expected.innerIndexPtr()[k], assembled.innerIndexPtr()[k]);
+    EXPECT_NEAR(expected.valuePtr()[k], assembled.valuePtr()[k], PRECISION);
+  }
+}
+
+// Testing solves of several right hand sides at once against solves of each of them
+TEST_F(SolverTest, MultipleRhsSolveTest01)
+{
+  SolverSetting setting;
+  setting.initialize(TEST_PATH+std::string("default_stgs.yaml"));
+
+  // upper triangle of a quasi-definite matrix with a coupling between both blocks
+  int n = 12, nrhs = 3;
+  Eigen::VectorXd sign(n);
+  std::vector<Eigen::Triplet<double>> coeffs;
+  for (int i=0; i<n; i++) {
+    sign[i] = i<n/2 ? 1.0 : -1.0;
+    coeffs.push_back(Eigen::Triplet<double>(i, i, 4.0*sign[i]));
+    if (i>=n/2) { coeffs.push_back(Eigen::Triplet<double>(i-n/2, i, 0.5+0.1*i)); }
+    if (i>=n/2+2) { coeffs.push_back(Eigen::Triplet<double>(i-n/2-2, i, -0.3)); }
+  }
+  Eigen::SparseMatrix<double> mat(n,n);
+  mat.setFromTriplets(coeffs.begin(), coeffs.end());
+
+  Eigen::MatrixXd rhs(n,nrhs);
+  for (int i=0; i<n; i++)
+    for (int k=0; k<nrhs; k++) { rhs(i,k) = std::sin(1.0+i+3.0*k); }
+
+  linalg::SparseCholesky sparse_cholesky;
+  linalg::DenseCholesky dense_cholesky;
+  sparse_cholesky.analyzePattern(mat, setting);
+  dense_cholesky.analyzePattern(mat, setting);
+  EXPECT_EQ(n, sparse_cholesky.factorize(mat, sign));
+  EXPECT_EQ(n, dense_cholesky.factorize(mat, sign));
+
+  Eigen::MatrixXd sparse_x = rhs, dense_x = rhs;
+  Eigen::Ref<Eigen::MatrixXd> sparse_ref = sparse_x, dense_ref = dense_x;
+  sparse_cholesky.solve(sparse_ref);
+  dense_cholesky.solve(dense_ref);
+
+  Eigen::VectorXd x(n);
+  Eigen::SparseMatrix<double> full = mat.selfadjointView<Eigen::Upper>();
+  for (int k=0; k<nrhs; k++) {
+    sparse_cholesky.solve(rhs.col(k), x.data());
+    for (int i=0; i<n; i++) {
+      EXPECT_NEAR(x[i], sparse_x(i,k), 1.e-12);
+      EXPECT_NEAR(x[i], dense_x(i,k), 1.e-12);
+    }
+    EXPECT_NEAR(0.0, (full*sparse_x.col(k)-rhs.col(k)).lpNorm<Eigen::Infinity>(), 1.e-8);
+  }
+}
+
+// Testing dense factorization of small kkt matrices against the sparse one
+TEST_F(SolverTest, DenseKktTest01)
+{
+  for (std::string cfg_file : {"test_01.yaml", "test_03.yaml", "test_05.yaml"}) {
+    double objective;
+    std::vector<double> xsparse, xdense;
+    EXPECT_EQ(ExitCode::Optimal, solveWithSetting(cfg_file, SolverIntParam_DenseKktThreshold, 0, xsparse, objective)) << cfg_file;
+    EXPECT_EQ(ExitCode::Optimal, solveWithSetting(cfg_file, SolverIntParam_DenseKktThreshold, 1000000, xdense, objective)) << cfg_file;
+    for (size_t var_id=0; var_id<xsparse.size(); var_id++) { EXPECT_NEAR(xsparse[var_id], xdense[var_id], PRECISION) << cfg_file; }
+  }
+}
+
+// Testing buffering of solver output while another thread drains it
+TEST_F(SolverTest, OutputSinkTest01)
+{
+  OutputSink sink;
+  std::ostringstream stream;
+  EXPECT_FALSE(sink.write("dropped before reserve\n"));
+
+  sink.reserve(4);
+  for (int line=0; line<6; line++) { sink.write("line %d\n", line); }
+  EXPECT_EQ(2, sink.droppedLines());
+  EXPECT_EQ(4, sink.drain(stream));
+  EXPECT_EQ("line 0\nline 1\nline 2\nline 3\n[2 lines of solver output dropped]\n", stream.str());
+
+  // every line written is either drained in order or counted as dropped
+  const int num_lines = 20000;
+  std::ostringstream concurrent_stream;
+  std::atomic<bool> is_done(false);
+  std::thread producer([&]() {
+    for (int line=0; line<num_lines; line++) { sink.write("%d\n", line); }
+    is_done = true;
+  });
+  while (!is_done) { sink.drain(concurrent_stream); }
+  producer.join();
+  sink.drain(concurrent_stream);
+
+  int num_drained = 0, previous = -1, line;
+  std::string text;
+  std::istringstream lines(concurrent_stream.str());
+  while (std::getline(lines, text)) {
+    if (std::sscanf(text.c_str(), "%d", &line)==1) { EXPECT_LT(previous, line); previous = line; num_drained++; }
+  }
+  EXPECT_GT(num_drained, 0);
+  EXPECT_LE(num_drained, num_lines);
+}
+
+// Testing independent solver instances optimizing concurrently
+TEST_F(SolverTest, ConcurrentSolversTest01)
+{
+  const int num_solvers = 4;
+  std::vector<double> objectives(num_solvers);
+  std::vector<std::vector<double>> xopt(num_solvers);
+  std::vector<ExitCode> exit_codes(num_solvers);
+  auto solve = [&](int solver_id) {
+    exit_codes[solver_id] = solveWithSetting("test_05.yaml", SolverIntParam_KktOrdering, static_cast<int>(KktOrdering::Amd), xopt[solver_id], objectives[solver_id]);
+  };
+
+  std::vector<std::thread> threads;
+  for (int solver_id=0; solver_id<num_solvers; solver_id++) { threads.push_back(std::thread(solve, solver_id)); }
+  for (std::thread& thread : threads) { thread.join(); }
+
+  for (int solver_id=0; solver_id<num_solvers; solver_id++) {
+    EXPECT_EQ(ExitCode::Optimal, exit_codes[solver_id]);
+    for (size_t var_id=0; var_id<xopt[0].size(); var_id++) { EXPECT_EQ(xopt[0][var_id], xopt[solver_id][var_id]); }
+  }
+}
+
+// Testing Gondzio centrality correctors against the plain predictor-corrector,
+// optimal points of these problems are not unique, their objectives are compared
+TEST_F(SolverTest, CentralityCorrectorsTest01)
+{
+  for (std::string cfg_file : {"test_01.yaml", "test_04.yaml", "test_05.yaml", "test_10.yaml", "test_12.yaml", "test_18.yaml"}) {
+    std::vector<double> xopt;
+    double objective, corrected_objective;
+    ExitCode exit_code = solveWithSetting(cfg_file, SolverIntParam_MaxCentralityCorrectors, 0, xopt, objective);
+    ExitCode corrected_exit_code = solveWithSetting(cfg_file, SolverIntParam_MaxCentralityCorrectors, 2, xopt, corrected_objective);
+
+    EXPECT_EQ(exit_code, corrected_exit_code) << cfg_file;
+    if (exit_code==ExitCode::Optimal) { EXPECT_NEAR(objective, corrected_objective, 1.e-6*std::max(1.0, std::abs(objective))) << cfg_file; }
+  }
+}
+
+// Testing dense insertion of small second order cones against their lifted representation,
+// cones of sizes 2 to 6 are all lifted, partly compact and all compact
+TEST_F(SolverTest, CompactSocTest01)
+{
+  std::vector<ExitCode> exit_codes;
+  std::vector<double> objectives;
+  for (int threshold : {0, 4, 1000}) {
+    Model model;
+    std::vector<Var> vars;
+    model.configSetting(TEST_PATH+std::string("default_stgs.yaml"));
+    model.getSetting().set(SolverBoolParam_Verbose, false);
+    model.getSetting().set(SolverIntParam_DenseSocThreshold, threshold);
+
+    LinExpr objective = 0.0;
+    for (int var_id=0; var_id<6; var_id++) {
+      vars.push_back(model.addVar(VarType::Continuous, -10.0, 10.0, 0.0));
+      objective += LinExpr(vars[var_id])*(var_id%2==0 ? 1.0 : -0.5*var_id);
+    }
+    for (int k=1; k<=5; k++) {
+      DCPQuadExpr qexpr;
+      for (int j=0; j<k; j++) { qexpr.addQuaTerm(1.0, LinExpr(vars[(k+j)%6]) + LinExpr(-0.1*k*j)); }
+      model.addSocConstr(qexpr, "<", LinExpr(1.0+0.5*k));
+    }
+    model.setObjective(DCPQuadExpr(), objective);
+
+    exit_codes.push_back(model.optimize());
+    objectives.push_back(0.0);
+    for (int var_id=0; var_id<6; var_id++) { objectives.back() += (var_id%2==0 ? 1.0 : -0.5*var_id)*vars[var_id].get(SolverDoubleParam_X); }
+  }
+
+  for (int run=1; run<3; run++) {
+    EXPECT_EQ(ExitCode::Optimal, exit_codes[run]);
+    EXPECT_NEAR(objectives[0], objectives[run], 1.e-6*std::max(1.0, std::abs(objectives[0])));
+  }
+}
+
+// Testing adaptive refinements of a nonconvex quadratic constraint, projection onto the unit circle:
+// stopping at convergence gives the solution of running all refinements, also with a trust region
+TEST_F(SolverTest, ScpRefinementsTest01)
+{
+  for (double radius : {SolverSetting::inf, 1.e-3}) {
+    std::vector<int> refinements;
+    std::vector<double> x0_values, x1_values, violations;
+    for (double tolerance : {0.0, 1.e-4}) {
+      Model model;
+      model.configSetting(TEST_PATH+std::string("default_stgs.yaml"));
+      model.getSetting().set(SolverBoolParam_Verbose, false);
+      model.getSetting().set(SolverIntParam_NumberRefinementsTrustRegion, 20);
+      model.getSetting().set(SolverDoubleParam_ScpInitialRadius, radius);
+      model.getSetting().set(SolverDoubleParam_ScpStepTolerance, tolerance);
+
+      Var x0 = model.addVar(VarType::Continuous, -2.0, 2.0, 0.9);
+      Var x1 = model.addVar(VarType::Continuous, -2.0, 2.0, 0.45);
+      DCPQuadExpr circle;
+      circle.addQuaTerm(1.0, LinExpr(x0));
+      circle.addQuaTerm(1.0, LinExpr(x1));
+      model.addQuaConstr(circle, "<", LinExpr(1.0), QuadConstrApprox::TrustRegion);
+
+      DCPQuadExpr distance;
+      distance.addQuaTerm(1.0, LinExpr(x0) - 0.2);
+      distance.addQuaTerm(1.0, LinExpr(x1) - 0.1);
+      model.setObjective(distance, LinExpr());
+      EXPECT_EQ(ExitCode::Optimal, model.optimize());
+
+      refinements.push_back(model.getProblem().getInfo().get(SolverIntParam_NumScpRefinements));
+      violations.push_back(model.getProblem().getInfo().get(SolverDoubleParam_NonconvexViolation));
+      x0_values.push_back(x0.get(SolverDoubleParam_X));
+      x1_values.push_back(x1.get(SolverDoubleParam_X));
+    }
+
+    EXPECT_LT(refinements[1], refinements[0]);
+    EXPECT_LT(violations[1], 1.e-6);
+    EXPECT_NEAR(x0_values[0], x0_values[1], 1.e-4);
+    EXPECT_NEAR(x1_values[0], x1_values[1], 1.e-4);
+    EXPECT_NEAR(2.0/std::sqrt(5.0), x0_values[1], PRECISION);
+    EXPECT_NEAR(1.0/std::sqrt(5.0), x1_values[1], PRECISION);
+  }
+
+  // with a soft constraint that is cheap in the merit function every refinement is rejected,
+  // so the solution and the info must stay those of the first solve
+  std::vector<int> iterations;
+  std::vector<double> x0_values, x1_values, costs;
+  for (int num_refinements : {0, 3}) {
+    Model model;
+    model.configSetting(TEST_PATH+std::string("default_stgs.yaml"));
+    model.getSetting().set(SolverBoolParam_Verbose, false);
+    model.getSetting().set(SolverIntParam_NumberRefinementsTrustRegion, num_refinements);
+    model.getSetting().set(SolverDoubleParam_SoftConstraintWeightFull, 1.e-3);
+
+    Var x0 = model.addVar(VarType::Continuous, -2.0, 2.0, 0.3);
+    Var x1 = model.addVar(VarType::Continuous, -2.0, 2.0, 0.15);
+    DCPQuadExpr disk;
+    disk.addQuaTerm(-1.0, LinExpr(x0));
+    disk.addQuaTerm(-1.0, LinExpr(x1));
+    model.addQuaConstr(disk, "<", LinExpr(-1.0), QuadConstrApprox::SoftConstraint);
+
+    DCPQuadExpr distance;
+    distance.addQuaTerm(1.0, LinExpr(x0) - 2.0);
+    distance.addQuaTerm(1.0, LinExpr(x1) - 1.0);
+    model.setObjective(distance, LinExpr());
+    EXPECT_EQ(ExitCode::Optimal, model.optimize());
+
+    EXPECT_EQ(num_refinements, model.getProblem().getInfo().get(SolverIntParam_NumScpRefinements));
+    iterations.push_back(model.getProblem().getInfo().get(SolverIntParam_NumIter));
+    costs.push_back(model.getProblem().getInfo().get(SolverDoubleParam_PrimalCost));
+    x0_values.push_back(x0.get(SolverDoubleParam_X));
+    x1_values.push_back(x1.get(SolverDoubleParam_X));
+  }
+
+  EXPECT_EQ(iterations[0], iterations[1]);
+  EXPECT_NEAR(costs[0], costs[1], PRECISION);
+  EXPECT_NEAR(x0_values[0], x0_values[1], PRECISION);
+  EXPECT_NEAR(x1_values[0], x1_values[1], PRECISION);
+  EXPECT_NEAR(std::pow(x0_values[1]-2.0, 2.0) + std::pow(x1_values[1]-1.0, 2.0), costs[1], 1.e-3);
+}
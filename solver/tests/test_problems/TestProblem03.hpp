@@ -66,5 +66,8 @@ namespace nlp_test_problems
       void evaluateConstraintsVector(int n_vars, int n_cons, const double* x, double* constraints)
       {
       }
+
+      // objective and constraints functions do not modify the problem
+      bool isThreadSafe() const { return true; }
   };
 }
@@ -0,0 +1,65 @@
+/**
+ * @file TestProblem04.hpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <test_problems/TestProblem01.hpp>
+
+namespace nlp_test_problems
+{
+
+  // problem of TestProblem01 with analytic derivatives and a sparse jacobian
+  class TestProblem04 : public TestProblem01
+  {
+    public:
+	  TestProblem04() : num_objective_evaluations_(0) {};
+      virtual ~TestProblem04(){};
+
+      // definition of objective function
+      double evaluateObjective(int n_vars, const double* x)
+      {
+        num_objective_evaluations_++;
+        return TestProblem01::evaluateObjective(n_vars, x);
+      }
+
+      // definition of objective gradient
+      bool hasObjectiveGradient() const { return true; }
+      void evaluateObjectiveGradient(int n_vars, const double* x, double* gradient)
+      {
+        gradient[0] = x[3]*( 2.*x[0]+x[1]+x[2] );
+        gradient[1] = x[0]*x[3];
+        gradient[2] = x[0]*x[3] + 1.;
+        gradient[3] = x[0]*( x[0]+x[1]+x[2] );
+      }
+
+      // definition of constraints jacobian, first row is stored column-wise to test the structure
+      bool hasConstraintsJacobian() const { return true; }
+      int getJacobianNonZeros(int n_vars, int n_cons) { return 8; }
+      void getJacobianStructure(int n_vars, int n_cons, int* rows, int* cols)
+      {
+        for (int id=0; id<4; id++)
+        {
+          rows[id] = 0;    cols[id] = 3-id;
+          rows[4+id] = 1;  cols[4+id] = id;
+        }
+      }
+      void evaluateConstraintsJacobian(int n_vars, int n_cons, const double* x, double* values)
+      {
+        values[0] = x[0]*x[1]*x[2];
+        values[1] = x[0]*x[1]*x[3];
+        values[2] = x[0]*x[2]*x[3];
+        values[3] = x[1]*x[2]*x[3];
+        for (int id=0; id<4; id++) { values[4+id] = 2.*x[id]; }
+      }
+
+      int numObjectiveEvaluations() const { return num_objective_evaluations_; }
+
+    private:
+      int num_objective_evaluations_;
+  };
+}
@@ -0,0 +1,35 @@
+/**
+ * @file TestProblem05.hpp
+ * @author agent (agent@local)
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2026, agent
+ * @date 2026-10-19
+ */
+
+#pragma once
+
+#include <test_problems/TestProblem03.hpp>
+
+namespace nlp_test_problems
+{
+
+  // problem of TestProblem03 with the upper bounds active at the solution
+  class TestProblem05 : public TestProblem03
+  {
+    public:
+	  TestProblem05(){};
+      virtual ~TestProblem05(){};
+
+      // definition of problem box constraints
+      void getNlpBounds(int n_vars, int n_cons, double* x_l, double* x_u, double* g_l, double* g_u)
+      {
+        for (int i=0; i<n_vars; i+=2)
+        {
+          x_l[i]   = -2.;
+          x_u[i]   =  0.5;
+          x_l[i+1] = -2.;
+          x_u[i+1] =  2.;
+        }
+      }
+  };
+}